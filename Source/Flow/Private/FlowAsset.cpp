@@ -2,18 +2,25 @@
 
 #include "FlowAsset.h"
 
+#include "FlowGroup.h"
 #include "FlowSettings.h"
 #include "FlowSubsystem.h"
 
 #include "Nodes/FlowNode.h"
 #include "Nodes/Route/FlowNode_CustomInput.h"
 #include "Nodes/Route/FlowNode_CustomOutput.h"
+#include "Nodes/Route/FlowNode_Finish.h"
 #include "Nodes/Route/FlowNode_Start.h"
 #include "Nodes/Route/FlowNode_SubGraph.h"
 
 #include "Engine/World.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectSaveContext.h"
+
+#if WITH_EDITOR && ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION > 3
+#include "Cooker/CookDependency.h"
+#endif
 
 #if WITH_EDITOR
 #include "FlowMessageLog.h"
@@ -41,7 +48,13 @@ UFlowAsset::UFlowAsset(const FObjectInitializer& ObjectInitializer)
 	, bStartNodePlacedAsGhostNode(false)
 	, TemplateAsset(nullptr)
 	, FinishPolicy(EFlowFinishPolicy::Keep)
+	, MemoryBudgetOverride(0)
+	, InstanceCreationTime(0.0)
 {
+#if WITH_EDITORONLY_DATA
+	bInlineOnCook = false;
+#endif
+
 	if (!AssetGuid.IsValid())
 	{
 		AssetGuid = FGuid::NewGuid();
@@ -81,6 +94,52 @@ void UFlowAsset::PostDuplicate(bool bDuplicateForPIE)
 	}
 }
 
+void UFlowAsset::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	// before inlining, inlined nodes keep references resolved against their own asset
+	ResolveVariableReferences();
+
+	if (ObjectSaveContext.IsCooking())
+	{
+		// in-editor cook saves the asset opened by user, its nodes are restored in PostSave
+		NodesBeforeCook = Nodes;
+		InlineSubGraphs();
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION > 3
+		// cooked nodes contain copies of inlined graphs, so these have to re-cook this asset
+		for (const FName& PackageName : InlinedSubGraphPackages)
+		{
+			ObjectSaveContext.AddCookBuildDependency(UE::Cook::FCookDependency::Package(PackageName));
+		}
+#endif
+
+		// cooked output must not depend on the order of editing operations
+		Nodes.KeySort([](const FGuid& A, const FGuid& B)
+		{
+			return A < B;
+		});
+	}
+
+	HarvestStrippedNodeConnections();
+
+	if (ObjectSaveContext.IsCooking())
+	{
+		StrippedNodeConnections.KeySort([](const FGuid& A, const FGuid& B)
+		{
+			return A < B;
+		});
+	}
+}
+
+void UFlowAsset::PostSave(FObjectPostSaveContext ObjectSaveContext)
+{
+	Super::PostSave(ObjectSaveContext);
+
+	RestoreNodesBeforeCook();
+}
+
 void UFlowAsset::PostLoad()
 {
 	Super::PostLoad();
@@ -136,9 +195,116 @@ EDataValidationResult UFlowAsset::ValidateAsset(FFlowMessageLog& MessageLog)
 		}
 	}
 
+	ResolveVariableReferences(&MessageLog);
+
+	// inlining would change how this graph behaves, so it's kept as separate instance
+	FString InlineFailureReason;
+	if (bInlineOnCook && !CanBeInlined(&InlineFailureReason))
+	{
+		MessageLog.Warning(*FString::Printf(TEXT("Inline On Cook is ignored, %s"), *InlineFailureReason), this);
+	}
+
+	// validate parameter bindings, these break silently if node is removed or its property renamed
+	for (const FFlowAssetParameter& Parameter : Parameters)
+	{
+		for (const FFlowParameterBinding& Binding : Parameter.Bindings)
+		{
+			const UFlowNode* Node = Nodes.FindRef(Binding.NodeGuid);
+			if (Node == nullptr)
+			{
+				MessageLog.Error(*FString::Printf(TEXT("Parameter %s is bound to missing node %s"), *Parameter.Name.ToString(), *Binding.NodeGuid.ToString()), this);
+			}
+			else if (Node->GetClass()->FindPropertyByName(Binding.PropertyName) == nullptr)
+			{
+				MessageLog.Error(*FString::Printf(TEXT("Parameter %s is bound to missing property %s"), *Parameter.Name.ToString(), *Binding.PropertyName.ToString()), Node);
+			}
+		}
+	}
+
 	return MessageLog.Messages.Num() > 0 ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
 }
 
+void UFlowAsset::ResolveVariableReferences(FFlowMessageLog* MessageLog)
+{
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (Node.Value == nullptr)
+		{
+			continue;
+		}
+
+		ResolveVariableReferencesInStruct(Node.Value->GetClass(), Node.Value, Node.Value, MessageLog);
+	}
+}
+
+void UFlowAsset::ResolveVariableReferencesInStruct(const UStruct* Struct, void* Container, UFlowNode* Node, FFlowMessageLog* MessageLog)
+{
+	for (TFieldIterator<FProperty> PropertyIt(Struct); PropertyIt; ++PropertyIt)
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < PropertyIt->ArrayDim; ArrayIndex++)
+		{
+			ResolveVariableReferencesInValue(*PropertyIt, PropertyIt->ContainerPtrToValuePtr<void>(Container, ArrayIndex), Node, MessageLog);
+		}
+	}
+}
+
+void UFlowAsset::ResolveVariableReferencesInValue(const FProperty* Property, void* Value, UFlowNode* Node, FFlowMessageLog* MessageLog)
+{
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		if (StructProperty->Struct == FFlowVariableReference::StaticStruct())
+		{
+			FFlowVariableReference* Reference = static_cast<FFlowVariableReference*>(Value);
+			FFlowVariableStore::ResolveReference(Variables, *Reference);
+
+			if (MessageLog && !Reference->Name.IsNone() && !Reference->IsResolved())
+			{
+				MessageLog->Error(*FString::Printf(TEXT("Variable %s isn't declared in this asset"), *Reference->Name.ToString()), Node);
+			}
+		}
+		else
+		{
+			ResolveVariableReferencesInStruct(StructProperty->Struct, Value, Node, MessageLog);
+		}
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		// only structs can contain references
+		if (ArrayProperty->Inner->IsA<FStructProperty>())
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+			for (int32 Index = 0; Index < ArrayHelper.Num(); Index++)
+			{
+				ResolveVariableReferencesInValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index), Node, MessageLog);
+			}
+		}
+	}
+	else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		if (MapProperty->ValueProp->IsA<FStructProperty>())
+		{
+			FScriptMapHelper MapHelper(MapProperty, Value);
+			for (int32 Index = 0, NumLeft = MapHelper.Num(); NumLeft > 0; Index++)
+			{
+				if (MapHelper.IsValidIndex(Index))
+				{
+					ResolveVariableReferencesInValue(MapProperty->ValueProp, MapHelper.GetValuePtr(Index), Node, MessageLog);
+					NumLeft--;
+				}
+			}
+		}
+	}
+	else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		// resolving would modify hashed elements
+		const FStructProperty* ElementProperty = CastField<FStructProperty>(SetProperty->ElementProp);
+		if (MessageLog && ElementProperty && ElementProperty->Struct == FFlowVariableReference::StaticStruct())
+		{
+			MessageLog->Error(*FString::Printf(TEXT("Variable references in set %s aren't supported"), *SetProperty->GetName()), Node);
+		}
+	}
+}
+
 bool UFlowAsset::IsNodeClassAllowed(const UClass* FlowNodeClass, FText* OutOptionalFailureReason) const
 {
 	if (!IsValid(FlowNodeClass))
@@ -358,6 +524,254 @@ void UFlowAsset::HarvestNodeConnections()
 		}
 	}
 }
+
+bool UFlowAsset::CanBeInlined(FString* OutOptionalFailureReason) const
+{
+	const auto Fail = [OutOptionalFailureReason](const FString& Reason)
+	{
+		if (OutOptionalFailureReason)
+		{
+			*OutOptionalFailureReason = Reason;
+		}
+		return false;
+	};
+
+	if (InstanceQuota.IsLimited())
+	{
+		return Fail(TEXT("Instance Quota wouldn't apply to inlined graph"));
+	}
+
+	// parameters are applied to nodes of the instance, while inlined nodes are copies of template nodes
+	if (Parameters.Num() > 0)
+	{
+		return Fail(TEXT("Parameters wouldn't be applied to inlined nodes"));
+	}
+
+	// inlined nodes would read slots of the parent graph variable store
+	if (Variables.Num() > 0)
+	{
+		return Fail(TEXT("Variables would be shared with the parent graph"));
+	}
+
+	for (const TPair<FGuid, UFlowNode*>& Pair : Nodes)
+	{
+		// nodes opt in explicitly, state of inlined node would be saved and restored under the parent graph
+		const UFlowNode* Node = Pair.Value;
+		if (Node && !Node->CanBeInlined())
+		{
+			return Fail(FString::Printf(TEXT("node %s (%s) doesn't support inlining"), *Node->GetName(), *Node->GetClass()->GetName()));
+		}
+	}
+
+	return true;
+}
+
+void UFlowAsset::InlineSubGraphs()
+{
+	TArray<UFlowNode_SubGraph*> SubGraphNodes;
+	for (const TPair<FGuid, UFlowNode*>& Pair : Nodes)
+	{
+		if (UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(Pair.Value))
+		{
+			SubGraphNodes.Add(SubGraphNode);
+		}
+	}
+
+	for (UFlowNode_SubGraph* SubGraphNode : SubGraphNodes)
+	{
+		const UFlowAsset* SubGraphAsset = SubGraphNode->Asset.LoadSynchronous();
+		if (SubGraphAsset == nullptr || SubGraphAsset == this || !SubGraphAsset->bInlineOnCook)
+		{
+			continue;
+		}
+
+		FString FailureReason;
+		if (SubGraphNode->ParameterValues.Num() > 0)
+		{
+			UE_LOG(LogFlow, Warning, TEXT("%s isn't inlined into %s: %s provides Parameter Values"), *SubGraphAsset->GetName(), *GetName(), *SubGraphNode->GetName());
+			continue;
+		}
+		if (!SubGraphAsset->CanBeInlined(&FailureReason))
+		{
+			UE_LOG(LogFlow, Warning, TEXT("%s isn't inlined into %s: %s"), *SubGraphAsset->GetName(), *GetName(), *FailureReason);
+			continue;
+		}
+
+		InlinedSubGraphPackages.AddUnique(SubGraphAsset->GetPackage()->GetFName());
+
+		const FGuid& SubGraphGuid = SubGraphNode->GetGuid();
+
+		// signals leaving the Sub Graph go directly to nodes connected to the Sub Graph node outputs
+		TMap<FGuid, FName> ExitNodes;
+		for (const TPair<FGuid, UFlowNode*>& Pair : SubGraphAsset->Nodes)
+		{
+			if (Cast<UFlowNode_Finish>(Pair.Value))
+			{
+				ExitNodes.Add(Pair.Key, UFlowNode_SubGraph::FinishPin.PinName);
+			}
+			else if (const UFlowNode_CustomOutput* CustomOutput = Cast<UFlowNode_CustomOutput>(Pair.Value))
+			{
+				ExitNodes.Add(Pair.Key, CustomOutput->GetEventName());
+			}
+		}
+
+		const auto RemapConnection = [&](const FConnectedPin& Connection, FConnectedPin& OutConnection) -> bool
+		{
+			if (const FName* ExitPinName = ExitNodes.Find(Connection.NodeGuid))
+			{
+				if (SubGraphNode->Connections.Contains(*ExitPinName))
+				{
+					OutConnection = SubGraphNode->Connections.FindRef(*ExitPinName);
+					return true;
+				}
+				return false;
+			}
+
+			OutConnection = FConnectedPin(FGuid::Combine(SubGraphGuid, Connection.NodeGuid), Connection.PinName);
+			return true;
+		};
+
+		// signals entering the Sub Graph go directly to nodes connected to Start and Custom Input nodes
+		TMap<FName, FConnectedPin> EntryConnections;
+		for (const TPair<FGuid, UFlowNode*>& Pair : SubGraphAsset->Nodes)
+		{
+			const UFlowNode* ChildNode = Pair.Value;
+			if (ChildNode == nullptr || ChildNode->OutputPins.Num() == 0 || !ChildNode->Connections.Contains(ChildNode->OutputPins[0].PinName))
+			{
+				continue;
+			}
+
+			FName EntryPinName = NAME_None;
+			if (Cast<UFlowNode_Start>(ChildNode))
+			{
+				EntryPinName = UFlowNode_SubGraph::StartPin.PinName;
+			}
+			else if (const UFlowNode_CustomInput* CustomInput = Cast<UFlowNode_CustomInput>(ChildNode))
+			{
+				EntryPinName = CustomInput->GetEventName();
+			}
+
+			FConnectedPin EntryConnection;
+			if (!EntryPinName.IsNone() && RemapConnection(ChildNode->Connections.FindRef(ChildNode->OutputPins[0].PinName), EntryConnection))
+			{
+				EntryConnections.Add(EntryPinName, EntryConnection);
+			}
+		}
+
+		// copy all other nodes
+		for (const TPair<FGuid, UFlowNode*>& Pair : SubGraphAsset->Nodes)
+		{
+			UFlowNode* ChildNode = Pair.Value;
+			if (ChildNode == nullptr || ExitNodes.Contains(Pair.Key) || Cast<UFlowNode_Start>(ChildNode) || Cast<UFlowNode_CustomInput>(ChildNode))
+			{
+				continue;
+			}
+
+			const FGuid InlinedGuid = FGuid::Combine(SubGraphGuid, Pair.Key);
+			// name derived from the GUID keeps cooked output deterministic
+			const FName InlinedName = *FString::Printf(TEXT("%s_%s"), *ChildNode->GetClass()->GetName(), *InlinedGuid.ToString());
+			UFlowNode* InlinedNode = NewObject<UFlowNode>(this, ChildNode->GetClass(), InlinedName, RF_NoFlags, ChildNode);
+			InlinedNode->SetGuid(InlinedGuid);
+			InlinedNode->GraphNode = nullptr;
+
+			TMap<FName, FConnectedPin> InlinedConnections;
+			for (const TPair<FName, FConnectedPin>& Connection : ChildNode->Connections)
+			{
+				FConnectedPin InlinedConnection;
+				if (RemapConnection(Connection.Value, InlinedConnection))
+				{
+					InlinedConnections.Add(Connection.Key, InlinedConnection);
+				}
+			}
+			InlinedNode->SetConnections(InlinedConnections);
+
+			Nodes.Add(InlinedGuid, InlinedNode);
+		}
+
+		// redirect connections leading to the Sub Graph node
+		for (const TPair<FGuid, UFlowNode*>& Pair : Nodes)
+		{
+			UFlowNode* Node = Pair.Value;
+			if (Node == nullptr || Node->GetOuter() != this)
+			{
+				continue;
+			}
+
+			for (auto ConnectionIt = Node->Connections.CreateIterator(); ConnectionIt; ++ConnectionIt)
+			{
+				if (ConnectionIt.Value().NodeGuid == SubGraphGuid)
+				{
+					if (!ConnectionsBeforeInlining.Contains(Node))
+					{
+						ConnectionsBeforeInlining.Add(Node, Node->Connections);
+					}
+
+					if (const FConnectedPin* EntryConnection = EntryConnections.Find(ConnectionIt.Value().PinName))
+					{
+						ConnectionIt.Value() = *EntryConnection;
+					}
+					else
+					{
+						ConnectionIt.RemoveCurrent();
+					}
+				}
+			}
+		}
+
+		Nodes.Remove(SubGraphGuid);
+	}
+}
+
+void UFlowAsset::RestoreNodesBeforeCook()
+{
+	InlinedSubGraphPackages.Empty();
+
+	if (NodesBeforeCook.Num() == 0)
+	{
+		return;
+	}
+
+	for (const TPair<UFlowNode*, TMap<FName, FConnectedPin>>& Pair : ConnectionsBeforeInlining)
+	{
+		Pair.Key->SetConnections(Pair.Value);
+	}
+	ConnectionsBeforeInlining.Empty();
+
+	// copied nodes must not be saved with the editor asset
+	for (const TPair<FGuid, UFlowNode*>& Pair : Nodes)
+	{
+		if (Pair.Value && !NodesBeforeCook.Contains(Pair.Key))
+		{
+			Pair.Value->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional);
+			Pair.Value->MarkAsGarbage();
+		}
+	}
+
+	Nodes = NodesBeforeCook;
+	NodesBeforeCook.Empty();
+}
+
+void UFlowAsset::HarvestStrippedNodeConnections()
+{
+	StrippedNodeConnections.Empty();
+
+	for (const TPair<FGuid, UFlowNode*>& Pair : Nodes)
+	{
+		const UFlowNode* Node = Pair.Value;
+		if (Node && Node->GetCookTarget() != EFlowCookTarget::All)
+		{
+			// the same outputs that would be triggered by UFlowNode::OnPassThrough
+			FFlowPassThroughConnections& PassThrough = StrippedNodeConnections.Add(Pair.Key);
+			for (const FFlowPin& OutputPin : Node->OutputPins)
+			{
+				if (Node->Connections.Contains(OutputPin.PinName))
+				{
+					PassThrough.Connections.Add(Node->Connections.FindRef(OutputPin.PinName));
+				}
+			}
+		}
+	}
+}
 #endif
 
 UFlowNode* UFlowAsset::GetDefaultEntryNode() const
@@ -584,9 +998,19 @@ void UFlowAsset::InitializeInstance(const TWeakObjectPtr<UObject> InOwner, UFlow
 {
 	Owner = InOwner;
 	TemplateAsset = InTemplateAsset;
+	InstanceCreationTime = FPlatformTime::Seconds();
 
-	for (TPair<FGuid, UFlowNode*>& Node : Nodes)
+	for (auto NodeIt = Nodes.CreateIterator(); NodeIt; ++NodeIt)
 	{
+		TPair<FGuid, UFlowNode*>& Node = *NodeIt;
+
+		// node has been stripped from this target, execution passes through it via StrippedNodeConnections
+		if (Node.Value == nullptr)
+		{
+			NodeIt.RemoveCurrent();
+			continue;
+		}
+
 		UFlowNode* NewNodeInstance = NewObject<UFlowNode>(this, Node.Value->GetClass(), NAME_None, RF_Transient, Node.Value, false, nullptr);
 		Node.Value = NewNodeInstance;
 
@@ -597,8 +1021,16 @@ void UFlowAsset::InitializeInstance(const TWeakObjectPtr<UObject> InOwner, UFlow
 				CustomInputNodes.Emplace(CustomInput);
 			}
 		}
+	}
+
+	VariableStore.Initialize(Variables);
+
+	// parameters are applied once all nodes are duplicated, so template nodes are never modified
+	ApplyParameters();
 
-		NewNodeInstance->InitializeInstance();
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		Node.Value->InitializeInstance();
 	}
 }
 
@@ -612,12 +1044,23 @@ void UFlowAsset::DeinitializeInstance()
 		}
 	}
 
+	// Sub Graphs share the owner with their parent graph, only Root Flow keeps the group alive
+	UFlowGroup* OwningGroup = Cast<UFlowGroup>(GetOwner());
+	if (OwningGroup && !NodeOwningThisAssetInstance.IsValid() && GetFlowSubsystem())
+	{
+		GetFlowSubsystem()->OnGroupFlowFinished(OwningGroup, this);
+	}
+
 	if (TemplateAsset)
 	{
 		const int32 ActiveInstancesLeft = TemplateAsset->RemoveInstance(this);
-		if (ActiveInstancesLeft == 0 && GetFlowSubsystem())
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 		{
-			GetFlowSubsystem()->RemoveInstancedTemplate(TemplateAsset);
+			if (ActiveInstancesLeft == 0)
+			{
+				FlowSubsystem->RemoveInstancedTemplate(TemplateAsset);
+			}
+			FlowSubsystem->OnInstanceRemoved(this);
 		}
 	}
 }
@@ -745,6 +1188,13 @@ void UFlowAsset::TriggerInput(const FGuid& NodeGuid, const FName& PinName)
 
 		Node->TriggerInput(PinName);
 	}
+	else if (const FFlowPassThroughConnections* PassThrough = StrippedNodeConnections.Find(NodeGuid))
+	{
+		for (const FConnectedPin& Connection : PassThrough->Connections)
+		{
+			TriggerInput(Connection.NodeGuid, Connection.PinName);
+		}
+	}
 }
 
 void UFlowAsset::FinishNode(UFlowNode* Node)
@@ -798,14 +1248,125 @@ UFlowAsset* UFlowAsset::GetParentInstance() const
 	return NodeOwningThisAssetInstance.IsValid() ? NodeOwningThisAssetInstance.Get()->GetFlowAsset() : nullptr;
 }
 
+int64 UFlowAsset::GetInstanceMemoryBudget() const
+{
+	const int32 BudgetInKilobytes = MemoryBudgetOverride > 0 ? MemoryBudgetOverride : UFlowSettings::Get()->InstanceMemoryBudget;
+	return static_cast<int64>(BudgetInKilobytes) * 1024;
+}
+
+SIZE_T UFlowAsset::GetInstanceMemoryUsage() const
+{
+	SIZE_T Result = GetClass()->GetStructureSize()
+		+ ActiveSubGraphs.GetAllocatedSize()
+		+ CustomInputNodes.GetAllocatedSize()
+		+ PreloadedNodes.GetAllocatedSize()
+		+ ActiveNodes.GetAllocatedSize()
+		+ RecordedNodes.GetAllocatedSize()
+		+ VariableStore.GetAllocatedSize();
+
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (Node.Value)
+		{
+			// every instance owns copies of all nodes
+			Result += Node.Value->GetClass()->GetStructureSize() + Node.Value->GetRecordsAllocatedSize();
+		}
+	}
+
+	return Result;
+}
+
+SIZE_T UFlowAsset::CompactInstance()
+{
+	const SIZE_T SizeBeforeCompaction = GetInstanceMemoryUsage();
+
+	// node is recorded again every time it's activated, we only need to know it was active in the past
+	TSet<const UFlowNode*> UniqueRecordedNodes;
+	UniqueRecordedNodes.Reserve(RecordedNodes.Num());
+	RecordedNodes.RemoveAll([&UniqueRecordedNodes](const UFlowNode* Node)
+	{
+		bool bAlreadyRecorded = false;
+		UniqueRecordedNodes.Add(Node, &bAlreadyRecorded);
+		return Node == nullptr || bAlreadyRecorded;
+	});
+	RecordedNodes.Shrink();
+	ActiveNodes.Shrink();
+
+	// SubGraphs that already finished or have been garbage collected
+	for (auto It = ActiveSubGraphs.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid() || !It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	ActiveSubGraphs.Compact();
+	ActiveSubGraphs.Shrink();
+	PreloadedNodes.Shrink();
+
+	for (const TPair<FGuid, UFlowNode*>& Node : Nodes)
+	{
+		if (Node.Value)
+		{
+			Node.Value->CompactRecords();
+		}
+	}
+
+	const SIZE_T SizeAfterCompaction = GetInstanceMemoryUsage();
+	return SizeBeforeCompaction > SizeAfterCompaction ? SizeBeforeCompaction - SizeAfterCompaction : 0;
+}
+
+void UFlowAsset::ApplyParameters()
+{
+	for (const TPair<FName, FString>& ParameterValue : ParameterValues)
+	{
+		if (!Parameters.ContainsByPredicate([&ParameterValue](const FFlowAssetParameter& Parameter) { return Parameter.Name == ParameterValue.Key; }))
+		{
+			UE_LOG(LogFlow, Warning, TEXT("%s doesn't declare parameter %s, its value is ignored"), *GetName(), *ParameterValue.Key.ToString());
+		}
+	}
+
+	for (const FFlowAssetParameter& Parameter : Parameters)
+	{
+		const FString* Value = ParameterValues.Find(Parameter.Name);
+		if (Value == nullptr)
+		{
+			if (Parameter.DefaultValue.IsEmpty())
+			{
+				continue;
+			}
+			Value = &Parameter.DefaultValue;
+		}
+
+		for (const FFlowParameterBinding& Binding : Parameter.Bindings)
+		{
+			UFlowNode* Node = Nodes.FindRef(Binding.NodeGuid);
+			const FProperty* Property = Node ? Node->GetClass()->FindPropertyByName(Binding.PropertyName) : nullptr;
+			if (Property == nullptr)
+			{
+				UE_LOG(LogFlow, Warning, TEXT("%s: parameter %s is bound to missing node or property %s"), *GetName(), *Parameter.Name.ToString(), *Binding.PropertyName.ToString());
+				continue;
+			}
+
+			if (Property->ImportText_Direct(**Value, Property->ContainerPtrToValuePtr<void>(Node), Node, PPF_None) == nullptr)
+			{
+				UE_LOG(LogFlow, Warning, TEXT("%s: value '%s' of parameter %s can't be imported into %s.%s"), *GetName(), **Value, *Parameter.Name.ToString(), *Node->GetName(), *Property->GetName());
+			}
+		}
+	}
+}
+
 FFlowAssetSaveData UFlowAsset::SaveInstance(TArray<FFlowAssetSaveData>& SavedFlowInstances)
 {
 	FFlowAssetSaveData AssetRecord;
 	AssetRecord.WorldName = IsBoundToWorld() ? GetWorld()->GetName() : FString();
 	AssetRecord.InstanceName = GetName();
 
-	// opportunity to collect data before serializing asset
-	OnSave();
+	// opportunity to collect data before serializing asset, replay snapshots are captured without gameplay side effects
+	if (GetFlowSubsystem() == nullptr || !GetFlowSubsystem()->IsCapturingReplaySnapshot())
+	{
+		OnSave();
+	}
 
 	// iterate nodes
 	TArray<UFlowNode*> NodesInExecutionOrder;
@@ -849,6 +1410,16 @@ void UFlowAsset::LoadInstance(const FFlowAssetSaveData& AssetRecord)
 	FFlowArchive Ar(MemoryReader);
 	Serialize(Ar);
 
+	// restored parameter values might differ from values provided while creating this instance
+	ApplyParameters();
+
+	// variables have been added or removed since the game was saved, saved values can't be mapped to slots
+	if (!VariableStore.MatchesLayout(Variables))
+	{
+		UE_LOG(LogFlow, Warning, TEXT("%s: variables changed since the instance was saved, resetting them to default values"), *GetName());
+		VariableStore.Initialize(Variables);
+	}
+
 	PreStartFlow();
 
 	// iterate graph "from the end", backward to execution order
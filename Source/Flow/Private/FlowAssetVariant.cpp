@@ -0,0 +1,11 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowAssetVariant.h"
+#include "FlowAsset.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowAssetVariant)
+
+UFlowAssetVariant::UFlowAssetVariant(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
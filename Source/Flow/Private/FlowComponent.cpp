@@ -19,6 +19,7 @@
 
 UFlowComponent::UFlowComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, NotifyTagsFromAnotherComponentFrame(0)
 	, RootFlow(nullptr)
 	, bAutoStartRootFlow(true)
 	, RootFlowMode(EFlowNetMode::Authority)
@@ -298,6 +299,11 @@ void UFlowComponent::BulkNotifyGraph(const FGameplayTagContainer NotifyTags, con
 
 void UFlowComponent::OnRep_SentNotifyTags()
 {
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		FlowSubsystem->RecordRecentNotifies(this, RecentlySentNotifyTags);
+	}
+
 	for (const FGameplayTag& NotifyTag : RecentlySentNotifyTags)
 	{
 		OnNotifyFromComponent.Broadcast(this, NotifyTag);
@@ -344,36 +350,51 @@ void UFlowComponent::NotifyActor(const FGameplayTag ActorTag, const FGameplayTag
 {
 	if (IsFlowNetMode(NetMode) && NotifyTag.IsValid() && HasBegunPlay())
 	{
-		if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
 		{
+			// actors in unloaded World Partition cells receive notify once they stream in
+			FlowSubsystem->QueueNotifyForUnloadedActors(FGameplayTagContainer(ActorTag), EGameplayContainerMatchType::Any, true, FGameplayTagContainer(NotifyTag), this, false);
+
+			const bool bReplicate = IsNetMode(NM_DedicatedServer) || IsNetMode(NM_ListenServer);
 			for (const TWeakObjectPtr<UFlowComponent>& Component : FlowSubsystem->GetComponents<UFlowComponent>(ActorTag))
 			{
 				Component->ReceiveNotify.Broadcast(this, NotifyTag);
+
+				// replicated by the target, so only connections which have the target relevant receive it
+				if (bReplicate)
+				{
+					Component->ReplicateNotifyFromAnotherComponent(this, NotifyTag);
+				}
 			}
 		}
+	}
+}
 
-		if (IsNetMode(NM_DedicatedServer) || IsNetMode(NM_ListenServer))
-		{
-			NotifyTagsFromAnotherComponent.Empty();
-			NotifyTagsFromAnotherComponent.Add(FNotifyTagReplication(ActorTag, NotifyTag));
-		}
+void UFlowComponent::ReplicateNotifyFromAnotherComponent(UFlowComponent* Sender, const FGameplayTag& NotifyTag)
+{
+	// keep all notifies received during the same frame, so multiple senders don't override each other
+	if (NotifyTagsFromAnotherComponentFrame != GFrameCounter)
+	{
+		NotifyTagsFromAnotherComponent.Empty();
+		NotifyTagsFromAnotherComponentFrame = GFrameCounter;
 	}
+
+	NotifyTagsFromAnotherComponent.Add(FNotifyTagReplication(Sender, NotifyTag));
 }
 
 void UFlowComponent::OnRep_NotifyTagsFromAnotherComponent()
 {
-	if (const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	for (const FNotifyTagReplication& Notify : NotifyTagsFromAnotherComponent)
 	{
-		for (const FNotifyTagReplication& Notify : NotifyTagsFromAnotherComponent)
-		{
-			for (const TWeakObjectPtr<UFlowComponent>& Component : FlowSubsystem->GetComponents<UFlowComponent>(Notify.ActorTag))
-			{
-				Component->ReceiveNotify.Broadcast(this, Notify.NotifyTag);
-			}
-		}
+		ReceiveNotify.Broadcast(Notify.Sender, Notify.NotifyTag);
 	}
 }
 
+void UFlowComponent::NotifyValueChanged(const FName ValueName)
+{
+	OnWatchedValueChanged.Broadcast(this, ValueName);
+}
+
 void UFlowComponent::StartRootFlow()
 {
 	if (RootFlow && IsFlowNetMode(RootFlowMode))
@@ -382,7 +403,14 @@ void UFlowComponent::StartRootFlow()
 		{
 			VerifyIdentityTags();
 
-			FlowSubsystem->StartRootFlow(this, RootFlow, bAllowMultipleInstances);
+			if (RootFlowParameters.Num() > 0)
+			{
+				FlowSubsystem->StartRootFlowWithParameters(this, RootFlow, RootFlowParameters, bAllowMultipleInstances);
+			}
+			else
+			{
+				FlowSubsystem->StartRootFlow(this, RootFlow, bAllowMultipleInstances);
+			}
 		}
 	}
 }
@@ -456,8 +484,11 @@ FFlowComponentSaveData UFlowComponent::SaveInstance()
 	ComponentRecord.WorldName = GetWorld()->GetName();
 	ComponentRecord.ActorInstanceName = GetOwner()->GetName();
 
-	// opportunity to collect data before serializing component
-	OnSave();
+	// opportunity to collect data before serializing component, replay snapshots are captured without gameplay side effects
+	if (GetFlowSubsystem() == nullptr || !GetFlowSubsystem()->IsCapturingReplaySnapshot())
+	{
+		OnSave();
+	}
 
 	// serialize component
 	FMemoryWriter MemoryWriter(ComponentRecord.ComponentData, true);
@@ -0,0 +1,161 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowGroup.h"
+#include "FlowComponent.h"
+#include "FlowSubsystem.h"
+
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowGroup)
+
+UFlowGroup::UFlowGroup(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+UWorld* UFlowGroup::GetWorld() const
+{
+	if (const UFlowSubsystem* FlowSubsystem = GetTypedOuter<UFlowSubsystem>())
+	{
+		return FlowSubsystem->GetWorld();
+	}
+
+	return nullptr;
+}
+
+void UFlowGroup::AddMember(AActor* Actor)
+{
+	if (!IsValid(Actor) || IsMember(Actor))
+	{
+		return;
+	}
+
+	Members.Emplace(Actor);
+	if (MemberContextClass)
+	{
+		MemberContexts.Emplace(Actor, NewObject<UObject>(this, MemberContextClass));
+	}
+
+	Actor->OnEndPlay.AddUniqueDynamic(this, &UFlowGroup::OnMemberEndPlay);
+	OnMemberJoined.Broadcast(this, Actor);
+}
+
+void UFlowGroup::RemoveMember(AActor* Actor)
+{
+	if (Actor == nullptr || !IsMember(Actor))
+	{
+		return;
+	}
+
+	Actor->OnEndPlay.RemoveDynamic(this, &UFlowGroup::OnMemberEndPlay);
+
+	// context is still available while broadcasting
+	OnMemberLeft.Broadcast(this, Actor);
+
+	Members.Remove(Actor);
+	MemberContexts.Remove(Actor);
+}
+
+bool UFlowGroup::IsMember(const AActor* Actor) const
+{
+	return Members.Contains(Actor);
+}
+
+TArray<AActor*> UFlowGroup::GetMembers() const
+{
+	TArray<AActor*> Result;
+	Result.Reserve(Members.Num());
+
+	for (const TWeakObjectPtr<AActor>& Member : Members)
+	{
+		if (Member.IsValid())
+		{
+			Result.Emplace(Member.Get());
+		}
+	}
+
+	return Result;
+}
+
+UObject* UFlowGroup::GetMemberContext(AActor* Actor, const TSubclassOf<UObject> ContextClass) const
+{
+	UObject* Context = MemberContexts.FindRef(Actor);
+	return Context && (ContextClass == nullptr || Context->IsA(ContextClass)) ? Context : nullptr;
+}
+
+void UFlowGroup::StartTrackingMembers(UFlowSubsystem* FlowSubsystem)
+{
+	if (!MemberTags.IsValid())
+	{
+		return;
+	}
+
+	// collect already registered components
+	for (const TWeakObjectPtr<UFlowComponent>& FoundComponent : FlowSubsystem->GetComponents<UFlowComponent>(MemberTags, EGameplayContainerMatchType::Any, true))
+	{
+		AddMember(FoundComponent->GetOwner());
+	}
+
+	FlowSubsystem->OnComponentRegistered.AddUniqueDynamic(this, &UFlowGroup::OnComponentRegistered);
+	FlowSubsystem->OnComponentTagAdded.AddUniqueDynamic(this, &UFlowGroup::OnComponentTagAdded);
+	FlowSubsystem->OnComponentTagRemoved.AddUniqueDynamic(this, &UFlowGroup::OnComponentTagRemoved);
+	FlowSubsystem->OnComponentUnregistered.AddUniqueDynamic(this, &UFlowGroup::OnComponentUnregistered);
+}
+
+void UFlowGroup::StopTrackingMembers(UFlowSubsystem* FlowSubsystem)
+{
+	FlowSubsystem->OnComponentRegistered.RemoveDynamic(this, &UFlowGroup::OnComponentRegistered);
+	FlowSubsystem->OnComponentTagAdded.RemoveDynamic(this, &UFlowGroup::OnComponentTagAdded);
+	FlowSubsystem->OnComponentTagRemoved.RemoveDynamic(this, &UFlowGroup::OnComponentTagRemoved);
+	FlowSubsystem->OnComponentUnregistered.RemoveDynamic(this, &UFlowGroup::OnComponentUnregistered);
+
+	for (const TWeakObjectPtr<AActor>& Member : Members)
+	{
+		if (Member.IsValid())
+		{
+			Member->OnEndPlay.RemoveDynamic(this, &UFlowGroup::OnMemberEndPlay);
+		}
+	}
+
+	Members.Empty();
+	MemberContexts.Empty();
+}
+
+bool UFlowGroup::MatchesMemberTags(const UFlowComponent* Component) const
+{
+	return Component->IdentityTags.HasAnyExact(MemberTags);
+}
+
+void UFlowGroup::OnComponentRegistered(UFlowComponent* Component)
+{
+	if (MatchesMemberTags(Component))
+	{
+		AddMember(Component->GetOwner());
+	}
+}
+
+void UFlowGroup::OnComponentTagAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags)
+{
+	if (AddedTags.HasAnyExact(MemberTags))
+	{
+		AddMember(Component->GetOwner());
+	}
+}
+
+void UFlowGroup::OnComponentTagRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags)
+{
+	if (RemovedTags.HasAnyExact(MemberTags) && !MatchesMemberTags(Component))
+	{
+		RemoveMember(Component->GetOwner());
+	}
+}
+
+void UFlowGroup::OnComponentUnregistered(UFlowComponent* Component)
+{
+	RemoveMember(Component->GetOwner());
+}
+
+void UFlowGroup::OnMemberEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	RemoveMember(Actor);
+}
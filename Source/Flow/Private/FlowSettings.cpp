@@ -9,10 +9,20 @@ UFlowSettings::UFlowSettings(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, bCreateFlowSubsystemOnClients(true)
 	, bWarnAboutMissingIdentityTags(true)
+	, ReplaySnapshotInterval(0.0f)
+	, RecentNotifyRetention(0.0f)
+	, MaxQueuedNotifiesPerActor(16)
 	, bLogOnSignalDisabled(true)
 	, bLogOnSignalPassthrough(true)
 	, bUseAdaptiveNodeTitles(false)
 	, DefaultExpectedOwnerClass(UFlowComponent::StaticClass())
+	, InstanceMemoryBudget(0)
+	, CompactionInterval(60.0f)
+	, PreloadMemoryBudget(0)
+	, OrphanedRootFlowSweepInterval(10.0f)
+	, OrphanedRootFlowFinishPolicy(EFlowFinishPolicy::Keep)
+	, ComponentQueryCacheSize(256)
+	, MaxQueuedRootFlows(256)
 {
 }
 
@@ -3,15 +3,19 @@
 #include "FlowSubsystem.h"
 
 #include "FlowAsset.h"
+#include "FlowAssetVariant.h"
 #include "FlowComponent.h"
+#include "FlowGroup.h"
 #include "FlowLogChannels.h"
 #include "FlowSave.h"
 #include "FlowSettings.h"
 #include "Nodes/Route/FlowNode_SubGraph.h"
 
+#include "Engine/DemoNetDriver.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
 #include "Logging/MessageLog.h"
+#include "Kismet/GameplayStatics.h"
 #include "Misc/Paths.h"
 #include "UObject/UObjectHash.h"
 
@@ -22,10 +26,15 @@ FNativeFlowAssetEvent UFlowSubsystem::OnInstancedTemplateAdded;
 FNativeFlowAssetEvent UFlowSubsystem::OnInstancedTemplateRemoved;
 #endif
 
+const FString UFlowSubsystem::ReplaySnapshotGroup = TEXT("FlowSnapshot");
+
 #define LOCTEXT_NAMESPACE "FlowSubsystem"
 
 UFlowSubsystem::UFlowSubsystem()
 	: LoadedSaveGame(nullptr)
+	, RecordedReplaySnapshots(0)
+	, bCapturingReplaySnapshot(false)
+	, bBypassQuotas(false)
 {
 }
 
@@ -50,11 +59,60 @@ bool UFlowSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 void UFlowSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	const float CompactionInterval = UFlowSettings::Get()->CompactionInterval;
+	if (CompactionInterval > 0.0f)
+	{
+		CompactionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowSubsystem::TickCompaction), CompactionInterval);
+	}
+
+	const float OrphanSweepInterval = UFlowSettings::Get()->OrphanedRootFlowSweepInterval;
+	if (OrphanSweepInterval > 0.0f)
+	{
+		OrphanSweepTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowSubsystem::TickOrphanSweep), OrphanSweepInterval);
+	}
+
+	const float ReplaySnapshotInterval = UFlowSettings::Get()->ReplaySnapshotInterval;
+	if (ReplaySnapshotInterval > 0.0f)
+	{
+		ReplaySnapshotTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowSubsystem::TickReplaySnapshot), ReplaySnapshotInterval);
+		ReplayScrubHandle = FNetworkReplayDelegates::OnReplayScrubComplete.AddUObject(this, &UFlowSubsystem::OnReplayScrubComplete);
+	}
+
+	// zero interval, ticked every frame
+	InjectedEventsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowSubsystem::TickInjectedEvents));
 }
 
 void UFlowSubsystem::Deinitialize()
 {
+	FTSTicker::GetCoreTicker().RemoveTicker(CompactionTickerHandle);
+	CompactionTickerHandle.Reset();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(OrphanSweepTickerHandle);
+	OrphanSweepTickerHandle.Reset();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(ReplaySnapshotTickerHandle);
+	ReplaySnapshotTickerHandle.Reset();
+	FNetworkReplayDelegates::OnReplayScrubComplete.Remove(ReplayScrubHandle);
+
+	FTSTicker::GetCoreTicker().RemoveTicker(InjectedEventsTickerHandle);
+	InjectedEventsTickerHandle.Reset();
+	InjectedEvents.Empty();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(QueuedRootFlowsTickerHandle);
+	QueuedRootFlowsTickerHandle.Reset();
+	QueuedRootFlows.Empty();
+
+	ComponentQueryCache.Empty();
+
+	for (UFlowGroup* Group : Groups)
+	{
+		Group->StopTrackingMembers(this);
+	}
+	Groups.Empty();
+
 	AbortActiveFlows();
+	FlushPreloadedContent();
+	UnregisterComponentProxies();
 }
 
 void UFlowSubsystem::AbortActiveFlows()
@@ -94,7 +152,40 @@ void UFlowSubsystem::StartRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const
 #endif
 }
 
-UFlowAsset* UFlowSubsystem::CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances)
+void UFlowSubsystem::StartRootFlowWithParameters(UObject* Owner, UFlowAsset* FlowAsset, const TMap<FName, FString>& ParameterValues, const bool bAllowMultipleInstances /* = true */)
+{
+	if (FlowAsset)
+	{
+		if (UFlowAsset* NewFlow = CreateRootFlow(Owner, FlowAsset, bAllowMultipleInstances, ParameterValues))
+		{
+			NewFlow->StartFlow();
+		}
+	}
+#if WITH_EDITOR
+	else
+	{
+		FMessageLog("PIE").Error(LOCTEXT("StartRootFlowNullAsset", "Attempted to start Root Flow with a null asset."))
+		                  ->AddToken(FUObjectToken::Create(Owner));
+	}
+#endif
+}
+
+void UFlowSubsystem::StartRootFlowVariant(UObject* Owner, UFlowAssetVariant* Variant, const bool bAllowMultipleInstances /* = true */)
+{
+	if (Variant)
+	{
+		StartRootFlowWithParameters(Owner, Variant->FlowAsset.LoadSynchronous(), Variant->ParameterValues, bAllowMultipleInstances);
+	}
+#if WITH_EDITOR
+	else
+	{
+		FMessageLog("PIE").Error(LOCTEXT("StartRootFlowNullVariant", "Attempted to start Root Flow with a null variant."))
+		                  ->AddToken(FUObjectToken::Create(Owner));
+	}
+#endif
+}
+
+UFlowAsset* UFlowSubsystem::CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances, const TMap<FName, FString>& ParameterValues)
 {
 	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : RootInstances)
 	{
@@ -111,10 +202,22 @@ UFlowAsset* UFlowSubsystem::CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset
 		return nullptr;
 	}
 
-	UFlowAsset* NewFlow = CreateFlowInstance(Owner, FlowAsset);
+	switch (AdmitInstance(Owner, FlowAsset, true))
+	{
+		case EFlowAdmission::Rejected:
+			return nullptr;
+		case EFlowAdmission::Queued:
+			QueueRootFlow(Owner, FlowAsset, bAllowMultipleInstances, ParameterValues);
+			return nullptr;
+		default:
+			break;
+	}
+
+	UFlowAsset* NewFlow = CreateFlowInstance(Owner, FlowAsset, FString(), ParameterValues);
 	if (NewFlow)
 	{
 		RootInstances.Add(NewFlow, Owner);
+		WatchRootFlowOwner(Owner);
 	}
 
 	return NewFlow;
@@ -166,7 +269,24 @@ UFlowAsset* UFlowSubsystem::CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, cons
 	if (!InstancedSubFlows.Contains(SubGraphNode))
 	{
 		const TWeakObjectPtr<UObject> Owner = SubGraphNode->GetFlowAsset() ? SubGraphNode->GetFlowAsset()->GetOwner() : nullptr;
-		NewInstance = CreateFlowInstance(Owner, SubGraphNode->Asset, SavedInstanceName);
+
+		// Sub Graphs restored from SaveGame existed before, don't drop them
+		if (SavedInstanceName.IsEmpty())
+		{
+			UFlowAsset* SubGraphAsset = SubGraphNode->Asset.LoadSynchronous();
+			if (SubGraphAsset && AdmitInstance(Owner.Get(), SubGraphAsset, false) != EFlowAdmission::Admitted)
+			{
+				// parent graph would wait forever for the Sub Graph to finish
+				if (!bPreloading)
+				{
+					UE_LOG(LogFlow, Warning, TEXT("Sub Graph %s rejected by instance quota, %s continues via its Finish output"), *SubGraphAsset->GetName(), *SubGraphNode->GetName());
+					SubGraphNode->TriggerFirstOutput(true);
+				}
+				return nullptr;
+			}
+		}
+
+		NewInstance = CreateFlowInstance(Owner, SubGraphNode->Asset, SavedInstanceName, SubGraphNode->ParameterValues);
 
 		if (NewInstance)
 		{
@@ -211,7 +331,7 @@ void UFlowSubsystem::RemoveSubFlow(UFlowNode_SubGraph* SubGraphNode, const EFlow
 	}
 }
 
-UFlowAsset* UFlowSubsystem::CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, TSoftObjectPtr<UFlowAsset> FlowAsset, FString NewInstanceName)
+UFlowAsset* UFlowSubsystem::CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, TSoftObjectPtr<UFlowAsset> FlowAsset, FString NewInstanceName, const TMap<FName, FString>& ParameterValues)
 {
 	UFlowAsset* LoadedFlowAsset = FlowAsset.LoadSynchronous();
 	if (LoadedFlowAsset == nullptr)
@@ -226,6 +346,7 @@ UFlowAsset* UFlowSubsystem::CreateFlowInstance(const TWeakObjectPtr<UObject> Own
 	{
 		// Fix connections - even in packaged game if assets haven't been re-saved in the editor after changing node's definition
 		LoadedFlowAsset->HarvestNodeConnections();
+		LoadedFlowAsset->ResolveVariableReferences();
 	}
 #endif
 
@@ -236,6 +357,7 @@ UFlowAsset* UFlowSubsystem::CreateFlowInstance(const TWeakObjectPtr<UObject> Own
 	}
 
 	UFlowAsset* NewInstance = NewObject<UFlowAsset>(this, LoadedFlowAsset->GetClass(), *NewInstanceName, RF_Transient, LoadedFlowAsset, false, nullptr);
+	NewInstance->SetParameterValues(ParameterValues);
 	NewInstance->InitializeInstance(Owner, LoadedFlowAsset);
 
 	LoadedFlowAsset->AddInstance(NewInstance);
@@ -384,6 +506,7 @@ void UFlowSubsystem::LoadRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const F
 		if (AssetRecord.InstanceName == SavedAssetInstanceName
 			&& (FlowAsset->IsBoundToWorld() == false || AssetRecord.WorldName == GetWorld()->GetName()))
 		{
+			TGuardValue<bool> QuotaGuard(bBypassQuotas, true);
 			UFlowAsset* LoadedInstance = CreateRootFlow(Owner, FlowAsset, false);
 			if (LoadedInstance)
 			{
@@ -418,226 +541,1286 @@ void UFlowSubsystem::LoadSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString
 	}
 }
 
-void UFlowSubsystem::RegisterComponent(UFlowComponent* Component)
+void UFlowSubsystem::RecordReplaySnapshot()
 {
-	for (const FGameplayTag& Tag : Component->IdentityTags)
+	UWorld* World = GetWorld();
+	UDemoNetDriver* DemoNetDriver = World ? World->GetDemoNetDriver() : nullptr;
+	if (DemoNetDriver == nullptr || !DemoNetDriver->IsRecording())
 	{
-		if (Tag.IsValid())
-		{
-			FlowComponentRegistry.Emplace(Tag, Component);
-		}
+		return;
 	}
 
-	OnComponentRegistered.Broadcast(Component);
-}
-
-void UFlowSubsystem::OnIdentityTagAdded(UFlowComponent* Component, const FGameplayTag& AddedTag)
-{
-	FlowComponentRegistry.Emplace(AddedTag, Component);
+	if (ReplaySnapshotDriver.Get() != DemoNetDriver)
+	{
+		ReplaySnapshotDriver = DemoNetDriver;
+		RecordedReplaySnapshots = 0;
+		LastReplaySnapshot.Empty();
+	}
 
-	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
-	if (Component->IdentityTags.Num() > 1)
+	// the same data as regular SaveGame, so restoring it goes through the well-tested loading path
+	UFlowSaveGame* SaveGame = NewObject<UFlowSaveGame>(this);
 	{
-		OnComponentTagAdded.Broadcast(Component, FGameplayTagContainer(AddedTag));
+		TGuardValue<bool> SnapshotGuard(bCapturingReplaySnapshot, true);
+		OnGameSaved(SaveGame);
 	}
-	else
+
+	TArray<uint8> Snapshot;
+	if (UGameplayStatics::SaveGameToMemory(SaveGame, Snapshot) && Snapshot != LastReplaySnapshot)
 	{
-		OnComponentRegistered.Broadcast(Component);
+		// replay events aren't limited in size like replicated properties and never reach game clients
+		const FString EventName = FString::Printf(TEXT("%s_%d"), *ReplaySnapshotGroup, RecordedReplaySnapshots++);
+		DemoNetDriver->AddOrUpdateEvent(EventName, ReplaySnapshotGroup, FString(), Snapshot);
+
+		LastReplaySnapshot = MoveTemp(Snapshot);
 	}
 }
 
-void UFlowSubsystem::OnIdentityTagsAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags)
+void UFlowSubsystem::RestoreReplaySnapshot(const TArray<uint8>& Snapshot)
 {
-	for (const FGameplayTag& Tag : AddedTags)
+	UFlowSaveGame* SaveGame = Cast<UFlowSaveGame>(UGameplayStatics::LoadGameFromMemory(Snapshot));
+	if (SaveGame == nullptr)
 	{
-		FlowComponentRegistry.Emplace(Tag, Component);
+		UE_LOG(LogFlow, Warning, TEXT("Failed to restore Flow state from the replay snapshot"));
+		return;
 	}
 
-	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
-	if (Component->IdentityTags.Num() > AddedTags.Num())
-	{
-		OnComponentTagAdded.Broadcast(Component, AddedTags);
-	}
-	else
+	// state simulated before seeking is no longer valid
+	AbortActiveFlows();
+	OnGameLoaded(SaveGame);
+
+	TArray<TWeakObjectPtr<UFlowComponent>> ComponentsArray;
+	FlowComponentRegistry.GenerateValueArray(ComponentsArray);
+	const TSet<TWeakObjectPtr<UFlowComponent>> RegisteredComponents = TSet<TWeakObjectPtr<UFlowComponent>>(ComponentsArray);
+
+	for (const TWeakObjectPtr<UFlowComponent>& Component : RegisteredComponents)
 	{
-		OnComponentRegistered.Broadcast(Component);
+		if (Component.IsValid() && Component->LoadInstance() && Component->RootFlow)
+		{
+			Component->LoadRootFlow();
+		}
 	}
 }
 
-void UFlowSubsystem::UnregisterComponent(UFlowComponent* Component)
+void UFlowSubsystem::RequestReplaySnapshot(UWorld* InWorld)
 {
-	for (const FGameplayTag& Tag : Component->IdentityTags)
+	UDemoNetDriver* DemoNetDriver = InWorld->GetDemoNetDriver();
+	if (DemoNetDriver == nullptr || !DemoNetDriver->IsPlaying())
 	{
-		if (Tag.IsValid())
+		return;
+	}
+
+	const uint32 CurrentTimeMS = static_cast<uint32>(DemoNetDriver->GetDemoCurrentTime() * 1000.0f);
+	DemoNetDriver->EnumerateEvents(ReplaySnapshotGroup, FEnumerateEventsCallback::CreateWeakLambda(this, [this, CurrentTimeMS](const FEnumerateEventsResult& Result)
+	{
+		if (!Result.WasSuccessful())
 		{
-			FlowComponentRegistry.Remove(Tag, Component);
+			return;
 		}
-	}
 
-	OnComponentUnregistered.Broadcast(Component);
+		const FReplayEventListItem* LatestEvent = nullptr;
+		for (const FReplayEventListItem& Event : Result.ReplayEventList.ReplayEvents)
+		{
+			if (Event.Time1 <= CurrentTimeMS && (LatestEvent == nullptr || Event.Time1 > LatestEvent->Time1))
+			{
+				LatestEvent = &Event;
+			}
+		}
+
+		UDemoNetDriver* PlayingDriver = GetWorld() ? GetWorld()->GetDemoNetDriver() : nullptr;
+		if (LatestEvent && PlayingDriver)
+		{
+			PlayingDriver->RequestEventData(LatestEvent->ID, FRequestEventDataCallback::CreateWeakLambda(this, [this](const FRequestEventDataResult& DataResult)
+			{
+				if (DataResult.WasSuccessful())
+				{
+					RestoreReplaySnapshot(DataResult.ReplayEventListItem);
+				}
+			}));
+		}
+	}));
 }
 
-void UFlowSubsystem::OnIdentityTagRemoved(UFlowComponent* Component, const FGameplayTag& RemovedTag)
+bool UFlowSubsystem::TickReplaySnapshot(float DeltaTime)
 {
-	FlowComponentRegistry.Remove(RemovedTag, Component);
+	RecordReplaySnapshot();
+	return true;
+}
 
-	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
-	if (Component->IdentityTags.Num() > 0)
-	{
-		OnComponentTagRemoved.Broadcast(Component, FGameplayTagContainer(RemovedTag));
-	}
-	else
+void UFlowSubsystem::OnReplayScrubComplete(UWorld* InWorld)
+{
+	// checkpoint has been loaded, apply the snapshot recorded before it
+	if (InWorld && InWorld == GetWorld())
 	{
-		OnComponentUnregistered.Broadcast(Component);
+		RequestReplaySnapshot(InWorld);
 	}
 }
 
-void UFlowSubsystem::OnIdentityTagsRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags)
+void UFlowSubsystem::CompactInstances(const bool bIgnoreBudgets /* = false */)
 {
-	for (const FGameplayTag& Tag : RemovedTags)
-	{
-		FlowComponentRegistry.Remove(Tag, Component);
-	}
+	CompactionStats.Passes++;
 
-	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
-	if (Component->IdentityTags.Num() > 0)
+	// entries left by objects destroyed without properly finishing their flows
+	for (auto It = InstancedSubFlows.CreateIterator(); It; ++It)
 	{
-		OnComponentTagRemoved.Broadcast(Component, RemovedTags);
+		if (!IsValid(It.Key()) || !IsValid(It.Value()))
+		{
+			It.RemoveCurrent();
+			CompactionStats.RemovedStaleEntries++;
+		}
 	}
-	else
+	InstancedSubFlows.Compact();
+
+	for (auto It = RootInstances.CreateIterator(); It; ++It)
 	{
-		OnComponentUnregistered.Broadcast(Component);
+		if (!IsValid(It.Key()))
+		{
+			It.RemoveCurrent();
+			CompactionStats.RemovedStaleEntries++;
+		}
 	}
-}
+	RootInstances.Compact();
 
-TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTag(const FGameplayTag Tag, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
-{
-	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tag, bExactMatch, FoundComponents);
+	PruneRecentNotifies();
 
-	TSet<UFlowComponent*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	SIZE_T ReclaimedBytes = 0;
+	for (const UFlowAsset* Template : InstancedTemplates)
 	{
-		if (Component.IsValid() && Component->GetClass()->IsChildOf(ComponentClass))
+		if (Template == nullptr)
 		{
-			Result.Emplace(Component.Get());
+			continue;
 		}
-	}
 
-	return Result;
-}
+		for (UFlowAsset* Instance : Template->ActiveInstances)
+		{
+			if (Instance == nullptr)
+			{
+				continue;
+			}
 
-TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
-{
-	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
+			const int64 MemoryBudget = Instance->GetInstanceMemoryBudget();
+			if (bIgnoreBudgets || (MemoryBudget > 0 && static_cast<int64>(Instance->GetInstanceMemoryUsage()) > MemoryBudget))
+			{
+				ReclaimedBytes += Instance->CompactInstance();
+				CompactionStats.CompactedInstances++;
+			}
+		}
+	}
 
-	TSet<UFlowComponent*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	if (ReclaimedBytes > 0)
 	{
-		if (Component.IsValid() && Component->GetClass()->IsChildOf(ComponentClass))
-		{
-			Result.Emplace(Component.Get());
-		}
+		CompactionStats.ReclaimedBytes += ReclaimedBytes;
+		UE_LOG(LogFlow, Verbose, TEXT("Flow instances compaction reclaimed %llu bytes"), static_cast<uint64>(ReclaimedBytes));
 	}
+}
 
-	return Result;
+bool UFlowSubsystem::TickCompaction(float DeltaTime)
+{
+	CompactInstances();
+	return true;
 }
 
-TSet<AActor*> UFlowSubsystem::GetFlowActorsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+int32 UFlowSubsystem::ReapOrphanedRootFlows()
 {
-	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tag, bExactMatch, FoundComponents);
+	OrphanStats.Sweeps++;
 
-	TSet<AActor*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	// weak pointer becomes stale once owner is destroyed, null owners were never valid and aren't considered orphans
+	TArray<UFlowAsset*> OrphanedInstances;
+	for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : RootInstances)
 	{
-		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
+		if (RootInstance.Key && RootInstance.Value.IsStale(true))
 		{
-			Result.Emplace(Component->GetOwner());
+			OrphanedInstances.Emplace(RootInstance.Key);
 		}
 	}
 
-	return Result;
+	const EFlowFinishPolicy FinishPolicy = UFlowSettings::Get()->OrphanedRootFlowFinishPolicy;
+	for (UFlowAsset* OrphanedInstance : OrphanedInstances)
+	{
+		UE_LOG(LogFlow, Verbose, TEXT("Finishing Root Flow %s, its owner has been destroyed"), *OrphanedInstance->GetName());
+
+		RootInstances.Remove(OrphanedInstance);
+		OrphanedInstance->FinishFlow(FinishPolicy);
+	}
+
+	OrphanStats.ReapedBySweep += OrphanedInstances.Num();
+	return OrphanedInstances.Num();
 }
 
-TSet<AActor*> UFlowSubsystem::GetFlowActorsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+void UFlowSubsystem::WatchRootFlowOwner(UObject* Owner)
 {
-	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
-
-	TSet<AActor*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	// Flow Component finishes its Root Flows on its own
+	AActor* OwningActor = Cast<AActor>(Owner);
+	if (OwningActor && !OwningActor->OnEndPlay.IsAlreadyBound(this, &UFlowSubsystem::OnRootFlowOwnerEndPlay))
 	{
-		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
-		{
-			Result.Emplace(Component->GetOwner());
-		}
+		OwningActor->OnEndPlay.AddDynamic(this, &UFlowSubsystem::OnRootFlowOwnerEndPlay);
 	}
-
-	return Result;
 }
 
-TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+void UFlowSubsystem::OnRootFlowOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
 {
-	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tag, bExactMatch, FoundComponents);
+	Actor->OnEndPlay.RemoveDynamic(this, &UFlowSubsystem::OnRootFlowOwnerEndPlay);
 
-	TMap<AActor*, UFlowComponent*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
-	{
-		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
-		{
-			Result.Emplace(Component->GetOwner(), Component.Get());
-		}
-	}
+	const int32 NumRootInstances = RootInstances.Num();
+	FinishAllRootFlows(Actor, UFlowSettings::Get()->OrphanedRootFlowFinishPolicy);
 
-	return Result;
+	OrphanStats.ReapedOnEndPlay += NumRootInstances - RootInstances.Num();
 }
 
-TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+bool UFlowSubsystem::TickOrphanSweep(float DeltaTime)
 {
-	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
-	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
+	ReapOrphanedRootFlows();
+	return true;
+}
 
-	TMap<AActor*, UFlowComponent*> Result;
-	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
-	{
-		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
-		{
-			Result.Emplace(Component->GetOwner(), Component.Get());
-		}
-	}
+void UFlowSubsystem::InjectNotifyGraph(UFlowComponent* Component, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+{
+	InjectedEvents.Enqueue(FFlowInjectedEvent(EFlowInjectedEventType::NotifyGraph, Component, NotifyTag, NAME_None, NetMode));
+}
 
-	return Result;
+void UFlowSubsystem::InjectAddIdentityTag(UFlowComponent* Component, const FGameplayTag& Tag, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+{
+	InjectedEvents.Enqueue(FFlowInjectedEvent(EFlowInjectedEventType::AddIdentityTag, Component, Tag, NAME_None, NetMode));
 }
 
-void UFlowSubsystem::FindComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+void UFlowSubsystem::InjectRemoveIdentityTag(UFlowComponent* Component, const FGameplayTag& Tag, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
 {
-	if (bExactMatch)
+	InjectedEvents.Enqueue(FFlowInjectedEvent(EFlowInjectedEventType::RemoveIdentityTag, Component, Tag, NAME_None, NetMode));
+}
+
+void UFlowSubsystem::InjectCustomInput(UFlowAsset* FlowAsset, const FName& EventName)
+{
+	InjectedEvents.Enqueue(FFlowInjectedEvent(EFlowInjectedEventType::CustomInput, FlowAsset, FGameplayTag(), EventName, EFlowNetMode::Any));
+}
+
+void UFlowSubsystem::DrainInjectedEvents()
+{
+	check(IsInGameThread());
+
+	if (InjectedEvents.IsEmpty())
 	{
-		FlowComponentRegistry.MultiFind(Tag, OutComponents);
+		return;
 	}
-	else
+
+	TArray<FFlowInjectedEvent> Events;
+	FFlowInjectedEvent Event;
+	while (InjectedEvents.Dequeue(Event))
 	{
-		for (TMultiMap<FGameplayTag, TWeakObjectPtr<UFlowComponent>>::TConstIterator It(FlowComponentRegistry); It; ++It)
+		Events.Emplace(MoveTemp(Event));
+	}
+
+	// walk backwards, so only the latest of coalesced events survives
+	TMultiMap<uint32, int32> LatestEvents;
+	TBitArray<> ExecutedEvents(false, Events.Num());
+	for (int32 Index = Events.Num() - 1; Index >= 0; Index--)
+	{
+		const uint32 Hash = Events[Index].GetCoalescingHash();
+
+		bool bCoalesced = false;
+		for (auto It = LatestEvents.CreateConstKeyIterator(Hash); It; ++It)
 		{
-			if (It.Key().MatchesTag(Tag))
+			if (Events[It.Value()].IsCoalescedWith(Events[Index]))
 			{
-				OutComponents.Emplace(It.Value());
+				bCoalesced = true;
+				break;
 			}
 		}
+
+		if (bCoalesced)
+		{
+			InjectionStats.CoalescedEvents++;
+		}
+		else
+		{
+			LatestEvents.Add(Hash, Index);
+			ExecutedEvents[Index] = true;
+		}
 	}
-}
 
-void UFlowSubsystem::FindComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+	for (int32 Index = 0; Index < Events.Num(); Index++)
+	{
+		if (!ExecutedEvents[Index])
+		{
+			continue;
+		}
+
+		if (Events[Index].Target.IsValid())
+		{
+			ExecuteInjectedEvent(Events[Index]);
+			InjectionStats.ExecutedEvents++;
+		}
+		else
+		{
+			InjectionStats.DiscardedEvents++;
+		}
+	}
+}
+
+void UFlowSubsystem::ExecuteInjectedEvent(const FFlowInjectedEvent& Event)
+{
+	switch (Event.Type)
+	{
+		case EFlowInjectedEventType::NotifyGraph:
+			if (UFlowComponent* Component = Cast<UFlowComponent>(Event.Target.Get()))
+			{
+				Component->NotifyGraph(Event.Tag, Event.NetMode);
+			}
+			break;
+		case EFlowInjectedEventType::AddIdentityTag:
+			if (UFlowComponent* Component = Cast<UFlowComponent>(Event.Target.Get()))
+			{
+				Component->AddIdentityTag(Event.Tag, Event.NetMode);
+			}
+			break;
+		case EFlowInjectedEventType::RemoveIdentityTag:
+			if (UFlowComponent* Component = Cast<UFlowComponent>(Event.Target.Get()))
+			{
+				Component->RemoveIdentityTag(Event.Tag, Event.NetMode);
+			}
+			break;
+		case EFlowInjectedEventType::CustomInput:
+			if (UFlowAsset* FlowAsset = Cast<UFlowAsset>(Event.Target.Get()))
+			{
+				FlowAsset->TriggerCustomInput(Event.EventName);
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+bool UFlowSubsystem::TickInjectedEvents(float DeltaTime)
+{
+	DrainInjectedEvents();
+	return true;
+}
+
+UFlowGroup* UFlowSubsystem::StartGroupFlow(UFlowAsset* FlowAsset, const FGameplayTagContainer MemberTags, const TSubclassOf<UObject> MemberContextClass /* = nullptr */)
+{
+	if (FlowAsset == nullptr)
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Attempted to start Group Flow with a null asset."));
+		return nullptr;
+	}
+
+	UFlowGroup* Group = NewObject<UFlowGroup>(this);
+	Group->MemberTags = MemberTags;
+	Group->MemberContextClass = MemberContextClass;
+	Groups.Emplace(Group);
+
+	// graph might iterate members as soon as it starts
+	Group->StartTrackingMembers(this);
+
+	if (UFlowAsset* NewFlow = CreateRootFlow(Group, FlowAsset))
+	{
+		NewFlow->StartFlow();
+	}
+	else if (!IsRootFlowQueued(Group, FlowAsset))
+	{
+		// graph won't ever start, so nothing would release the group
+		Groups.Remove(Group);
+		Group->StopTrackingMembers(this);
+		return nullptr;
+	}
+
+	return Group;
+}
+
+void UFlowSubsystem::OnGroupFlowFinished(UFlowGroup* Group, UFlowAsset* Instance)
+{
+	RootInstances.Remove(Instance);
+
+	// group exists only to own its Root Flows, FinishGroupFlow already released it if it's no longer listed
+	if (Groups.Contains(Group) && GetRootInstancesByOwner(Group).Num() == 0 && !IsRootFlowQueued(Group, nullptr))
+	{
+		Groups.Remove(Group);
+		Group->StopTrackingMembers(this);
+	}
+}
+
+EFlowAdmission UFlowSubsystem::AdmitInstance(UObject* Owner, UFlowAsset* FlowAsset, const bool bRootFlow)
+{
+	if (bBypassQuotas)
+	{
+		return EFlowAdmission::Admitted;
+	}
+
+	const FFlowInstanceQuota& TemplateQuota = FlowAsset->GetInstanceQuota();
+	if (TemplateQuota.IsLimited() && FlowAsset->GetInstancesNum() >= TemplateQuota.MaxInstances)
+	{
+		const EFlowAdmission Admission = ApplyQuotaPolicy(TemplateQuota, bRootFlow, [FlowAsset](const UFlowAsset* Instance)
+		{
+			return Instance->GetTemplateAsset() == FlowAsset;
+		}, FString::Printf(TEXT("template %s"), *FlowAsset->GetName()));
+
+		if (Admission != EFlowAdmission::Admitted)
+		{
+			return Admission;
+		}
+	}
+
+	if (Owner)
+	{
+		for (const TPair<TSoftClassPtr<UObject>, FFlowInstanceQuota>& Quota : UFlowSettings::Get()->OwnerClassQuotas)
+		{
+			// class that isn't loaded can't own any instance
+			const UClass* OwnerClass = Quota.Key.Get();
+			if (!Quota.Value.IsLimited() || OwnerClass == nullptr || !Owner->IsA(OwnerClass))
+			{
+				continue;
+			}
+
+			if (GetNumInstancesOwnedBy(OwnerClass) >= Quota.Value.MaxInstances)
+			{
+				const EFlowAdmission Admission = ApplyQuotaPolicy(Quota.Value, bRootFlow, [OwnerClass](const UFlowAsset* Instance)
+				{
+					return Instance->GetOwner() && Instance->GetOwner()->IsA(OwnerClass);
+				}, FString::Printf(TEXT("owner class %s"), *OwnerClass->GetName()));
+
+				if (Admission != EFlowAdmission::Admitted)
+				{
+					return Admission;
+				}
+			}
+		}
+	}
+
+	return EFlowAdmission::Admitted;
+}
+
+EFlowAdmission UFlowSubsystem::ApplyQuotaPolicy(const FFlowInstanceQuota& Quota, const bool bRootFlow, TFunctionRef<bool(const UFlowAsset*)> IsWithinQuota, const FString& QuotaDescription)
+{
+	switch (Quota.Policy)
+	{
+		case EFlowQuotaPolicy::EvictOldest:
+		{
+			// only Root Flows can be evicted, aborting Sub Graph would break its parent graph
+			UFlowAsset* OldestInstance = nullptr;
+			for (const TPair<UFlowAsset*, TWeakObjectPtr<UObject>>& RootInstance : RootInstances)
+			{
+				if (RootInstance.Key && IsWithinQuota(RootInstance.Key)
+					&& (OldestInstance == nullptr || RootInstance.Key->GetInstanceCreationTime() < OldestInstance->GetInstanceCreationTime()))
+				{
+					OldestInstance = RootInstance.Key;
+				}
+			}
+
+			if (OldestInstance)
+			{
+				UE_LOG(LogFlow, Warning, TEXT("Quota of %s exceeded (%d instances), aborting the oldest Root Flow %s"), *QuotaDescription, Quota.MaxInstances, *OldestInstance->GetName());
+				QuotaStats.Evicted++;
+
+				RootInstances.Remove(OldestInstance);
+				OldestInstance->FinishFlow(EFlowFinishPolicy::Abort);
+				return EFlowAdmission::Admitted;
+			}
+			break;
+		}
+		case EFlowQuotaPolicy::Queue:
+			if (bRootFlow)
+			{
+				UE_LOG(LogFlow, Warning, TEXT("Quota of %s exceeded (%d instances), new Root Flow will wait until other instance is removed"), *QuotaDescription, Quota.MaxInstances);
+				return EFlowAdmission::Queued;
+			}
+			break;
+		default:
+			break;
+	}
+
+	UE_LOG(LogFlow, Warning, TEXT("Quota of %s exceeded (%d instances), new instance has been rejected"), *QuotaDescription, Quota.MaxInstances);
+	QuotaStats.Rejected++;
+	return EFlowAdmission::Rejected;
+}
+
+int32 UFlowSubsystem::GetNumInstancesOwnedBy(const UClass* OwnerClass) const
+{
+	int32 Result = 0;
+	for (const UFlowAsset* Template : InstancedTemplates)
+	{
+		for (const UFlowAsset* Instance : Template->GetActiveInstances())
+		{
+			if (Instance && Instance->GetOwner() && Instance->GetOwner()->IsA(OwnerClass))
+			{
+				Result++;
+			}
+		}
+	}
+	return Result;
+}
+
+bool UFlowSubsystem::IsRootFlowQueued(const UObject* Owner, const UFlowAsset* FlowAsset) const
+{
+	for (const FFlowQueuedRootFlow& QueuedRootFlow : QueuedRootFlows)
+	{
+		if (QueuedRootFlow.Owner == Owner && (FlowAsset == nullptr || QueuedRootFlow.FlowAsset == FlowAsset))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UFlowSubsystem::QueueRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances, const TMap<FName, FString>& ParameterValues)
+{
+	for (const FFlowQueuedRootFlow& QueuedRootFlow : QueuedRootFlows)
+	{
+		if (QueuedRootFlow.Owner == Owner && QueuedRootFlow.FlowAsset == FlowAsset)
+		{
+			return;
+		}
+	}
+
+	if (QueuedRootFlows.Num() >= UFlowSettings::Get()->MaxQueuedRootFlows)
+	{
+		UE_LOG(LogFlow, Warning, TEXT("Too many Root Flows waiting for free quota, rejected %s. Owner: %s"), *FlowAsset->GetName(), *GetNameSafe(Owner));
+		QuotaStats.Rejected++;
+		return;
+	}
+
+	QueuedRootFlows.Emplace(Owner, FlowAsset, bAllowMultipleInstances, ParameterValues);
+	QuotaStats.Queued++;
+}
+
+void UFlowSubsystem::OnInstanceRemoved(UFlowAsset* Instance)
+{
+	// quota can only be freed by removing an instance, so there's no point in retrying queued flows any other time
+	// retry is deferred to the next frame, removed instance might be in the middle of finishing or being evicted by another quota check
+	if (QueuedRootFlows.Num() > 0 && !QueuedRootFlowsTickerHandle.IsValid())
+	{
+		QueuedRootFlowsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UFlowSubsystem::RetryQueuedRootFlows));
+	}
+}
+
+bool UFlowSubsystem::RetryQueuedRootFlows(float DeltaTime)
+{
+	QueuedRootFlowsTickerHandle.Reset();
+
+	// first in, first out, Root Flow that still doesn't fit its quota doesn't block flows limited by other quotas
+	// flows that don't fit are queued again by CreateRootFlow, in the same order
+	TArray<FFlowQueuedRootFlow> PendingRootFlows = MoveTemp(QueuedRootFlows);
+	QueuedRootFlows.Reset();
+
+	for (const FFlowQueuedRootFlow& QueuedRootFlow : PendingRootFlows)
+	{
+		if (!QueuedRootFlow.Owner.IsValid() || !QueuedRootFlow.FlowAsset.IsValid())
+		{
+			continue;
+		}
+
+		if (UFlowAsset* NewFlow = CreateRootFlow(QueuedRootFlow.Owner.Get(), QueuedRootFlow.FlowAsset.Get(), QueuedRootFlow.bAllowMultipleInstances, QueuedRootFlow.ParameterValues))
+		{
+			QuotaStats.StartedFromQueue++;
+			NewFlow->StartFlow();
+		}
+		else if (IsRootFlowQueued(QueuedRootFlow.Owner.Get(), QueuedRootFlow.FlowAsset.Get()))
+		{
+			// still waiting, it's not a new request
+			QuotaStats.Queued--;
+		}
+	}
+
+	// one-shot, next retry is scheduled by removing another instance
+	return false;
+}
+
+void UFlowSubsystem::FinishGroupFlow(UFlowGroup* Group, const EFlowFinishPolicy FinishPolicy)
+{
+	if (Group && Groups.Remove(Group) > 0)
+	{
+		FinishAllRootFlows(Group, FinishPolicy);
+		Group->StopTrackingMembers(this);
+	}
+}
+
+void UFlowSubsystem::AcquirePreloadedContent(const FSoftObjectPath& AssetPath)
+{
+	if (AssetPath.IsNull())
+	{
+		return;
+	}
+
+	PreloadStats.Requests++;
+
+	FFlowPreloadedContent& Content = PreloadedContent.FindOrAdd(AssetPath);
+	Content.RefCount++;
+	Content.LastRequestTime = FPlatformTime::Seconds();
+
+	if (Content.Handle.IsValid())
+	{
+		PreloadStats.Hits++;
+	}
+	else
+	{
+		// completion delegate might be called instantly, if asset is already loaded
+		const TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate::CreateUObject(this, &UFlowSubsystem::OnPreloadCompleted, AssetPath));
+		PreloadedContent.FindChecked(AssetPath).Handle = Handle;
+	}
+}
+
+void UFlowSubsystem::ReleasePreloadedContent(const FSoftObjectPath& AssetPath)
+{
+	if (FFlowPreloadedContent* Content = PreloadedContent.Find(AssetPath))
+	{
+		Content->RefCount = FMath::Max(0, Content->RefCount - 1);
+		EvictPreloadedContent();
+	}
+}
+
+void UFlowSubsystem::OnPreloadCompleted(FSoftObjectPath AssetPath)
+{
+	if (FFlowPreloadedContent* Content = PreloadedContent.Find(AssetPath))
+	{
+		if (Content->Handle.IsValid())
+		{
+			PreloadStats.CachedBytes -= Content->EstimatedSize;
+			Content->EstimatedSize = EstimatePreloadedSize(*Content->Handle);
+			PreloadStats.CachedBytes += Content->EstimatedSize;
+		}
+
+		EvictPreloadedContent();
+	}
+}
+
+SIZE_T UFlowSubsystem::EstimatePreloadedSize(const FStreamableHandle& Handle)
+{
+	TArray<UObject*> ObjectsToVisit;
+	Handle.GetLoadedAssets(ObjectsToVisit);
+
+	SIZE_T Result = 0;
+	TSet<const UObject*> VisitedObjects;
+	while (ObjectsToVisit.Num() > 0)
+	{
+		const UObject* Object = ObjectsToVisit.Pop();
+
+		bool bAlreadyVisited = false;
+		VisitedObjects.Add(Object, &bAlreadyVisited);
+
+		// native classes and their defaults weren't loaded by preloading
+		if (Object == nullptr || bAlreadyVisited || Object->GetOutermost()->HasAnyPackageFlags(PKG_CompiledIn))
+		{
+			continue;
+		}
+
+		// Exclusive mode, as every referenced object is visited separately
+		Result += Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+		FReferenceFinder ReferenceFinder(ObjectsToVisit, nullptr, false);
+		ReferenceFinder.FindReferences(const_cast<UObject*>(Object));
+	}
+
+	return Result;
+}
+
+void UFlowSubsystem::EvictPreloadedContent()
+{
+	const int64 MemoryBudget = static_cast<int64>(UFlowSettings::Get()->PreloadMemoryBudget) * 1024;
+
+	while (MemoryBudget == 0 || PreloadStats.CachedBytes > MemoryBudget)
+	{
+		// only content not needed by any node can be released
+		const FSoftObjectPath* LeastRecentlyNeeded = nullptr;
+		double OldestRequestTime = TNumericLimits<double>::Max();
+
+		for (const TPair<FSoftObjectPath, FFlowPreloadedContent>& Content : PreloadedContent)
+		{
+			if (Content.Value.RefCount == 0 && Content.Value.LastRequestTime < OldestRequestTime)
+			{
+				LeastRecentlyNeeded = &Content.Key;
+				OldestRequestTime = Content.Value.LastRequestTime;
+			}
+		}
+
+		if (LeastRecentlyNeeded == nullptr)
+		{
+			break;
+		}
+
+		if (MemoryBudget > 0)
+		{
+			PreloadStats.Evictions++;
+		}
+
+		RemovePreloadedContent(FSoftObjectPath(*LeastRecentlyNeeded));
+	}
+}
+
+void UFlowSubsystem::RemovePreloadedContent(const FSoftObjectPath& AssetPath)
+{
+	FFlowPreloadedContent Content;
+	if (PreloadedContent.RemoveAndCopyValue(AssetPath, Content))
+	{
+		if (Content.Handle.IsValid())
+		{
+			if (Content.Handle->IsLoadingInProgress())
+			{
+				Content.Handle->CancelHandle();
+			}
+			else
+			{
+				Content.Handle->ReleaseHandle();
+			}
+		}
+
+		PreloadStats.CachedBytes -= Content.EstimatedSize;
+	}
+}
+
+void UFlowSubsystem::FlushPreloadedContent()
+{
+	TArray<FSoftObjectPath> AssetPaths;
+	PreloadedContent.GetKeys(AssetPaths);
+
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		RemovePreloadedContent(AssetPath);
+	}
+}
+
+void UFlowSubsystem::RegisterComponent(UFlowComponent* Component)
+{
+	for (const FGameplayTag& Tag : Component->IdentityTags)
+	{
+		if (Tag.IsValid())
+		{
+			FlowComponentRegistry.Emplace(Tag, Component);
+		}
+	}
+	InvalidateComponentQueries(Component->IdentityTags);
+
+	OnComponentRegistered.Broadcast(Component);
+
+	if (ComponentProxies.Num() > 0)
+	{
+		const int32 ProxyIndex = FindProxyIndex(Component);
+		if (ProxyIndex != INDEX_NONE)
+		{
+			LoadedProxies.Add(ProxyIndex);
+		}
+	}
+
+	if (QueuedNotifies.Num() > 0)
+	{
+		DeliverQueuedNotifies(Component);
+	}
+}
+
+void UFlowSubsystem::OnIdentityTagAdded(UFlowComponent* Component, const FGameplayTag& AddedTag)
+{
+	FlowComponentRegistry.Emplace(AddedTag, Component);
+	InvalidateComponentQueries(FGameplayTagContainer(AddedTag));
+
+	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
+	if (Component->IdentityTags.Num() > 1)
+	{
+		OnComponentTagAdded.Broadcast(Component, FGameplayTagContainer(AddedTag));
+	}
+	else
+	{
+		OnComponentRegistered.Broadcast(Component);
+	}
+}
+
+void UFlowSubsystem::OnIdentityTagsAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags)
+{
+	for (const FGameplayTag& Tag : AddedTags)
+	{
+		FlowComponentRegistry.Emplace(Tag, Component);
+	}
+	InvalidateComponentQueries(AddedTags);
+
+	// broadcast OnComponentRegistered only if this component wasn't present in the registry previously
+	if (Component->IdentityTags.Num() > AddedTags.Num())
+	{
+		OnComponentTagAdded.Broadcast(Component, AddedTags);
+	}
+	else
+	{
+		OnComponentRegistered.Broadcast(Component);
+	}
+}
+
+void UFlowSubsystem::UnregisterComponent(UFlowComponent* Component)
+{
+	for (const FGameplayTag& Tag : Component->IdentityTags)
+	{
+		if (Tag.IsValid())
+		{
+			FlowComponentRegistry.Remove(Tag, Component);
+		}
+	}
+	InvalidateComponentQueries(Component->IdentityTags);
+
+	if (ComponentProxies.Num() > 0)
+	{
+		LoadedProxies.Remove(FindProxyIndex(Component));
+	}
+
+	OnComponentUnregistered.Broadcast(Component);
+}
+
+void UFlowSubsystem::OnIdentityTagRemoved(UFlowComponent* Component, const FGameplayTag& RemovedTag)
+{
+	FlowComponentRegistry.Remove(RemovedTag, Component);
+	InvalidateComponentQueries(FGameplayTagContainer(RemovedTag));
+
+	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
+	if (Component->IdentityTags.Num() > 0)
+	{
+		OnComponentTagRemoved.Broadcast(Component, FGameplayTagContainer(RemovedTag));
+	}
+	else
+	{
+		OnComponentUnregistered.Broadcast(Component);
+	}
+}
+
+void UFlowSubsystem::OnIdentityTagsRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags)
+{
+	for (const FGameplayTag& Tag : RemovedTags)
+	{
+		FlowComponentRegistry.Remove(Tag, Component);
+	}
+
+	InvalidateComponentQueries(RemovedTags);
+
+	// broadcast OnComponentUnregistered only if this component isn't present in the registry anymore
+	if (Component->IdentityTags.Num() > 0)
+	{
+		OnComponentTagRemoved.Broadcast(Component, RemovedTags);
+	}
+	else
+	{
+		OnComponentUnregistered.Broadcast(Component);
+	}
+}
+
+TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTag(const FGameplayTag Tag, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
+{
+	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
+	FindComponents(Tag, bExactMatch, FoundComponents);
+
+	TSet<UFlowComponent*> Result;
+	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	{
+		if (Component.IsValid() && Component->GetClass()->IsChildOf(ComponentClass))
+		{
+			Result.Emplace(Component.Get());
+		}
+	}
+
+	return Result;
+}
+
+TSet<UFlowComponent*> UFlowSubsystem::GetFlowComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<UFlowComponent> ComponentClass, const bool bExactMatch) const
+{
+	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
+	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
+
+	TSet<UFlowComponent*> Result;
+	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	{
+		if (Component.IsValid() && Component->GetClass()->IsChildOf(ComponentClass))
+		{
+			Result.Emplace(Component.Get());
+		}
+	}
+
+	return Result;
+}
+
+TSet<AActor*> UFlowSubsystem::GetFlowActorsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+{
+	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
+	FindComponents(Tag, bExactMatch, FoundComponents);
+
+	TSet<AActor*> Result;
+	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	{
+		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
+		{
+			Result.Emplace(Component->GetOwner());
+		}
+	}
+
+	return Result;
+}
+
+TSet<AActor*> UFlowSubsystem::GetFlowActorsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+{
+	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
+	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
+
+	TSet<AActor*> Result;
+	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	{
+		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
+		{
+			Result.Emplace(Component->GetOwner());
+		}
+	}
+
+	return Result;
+}
+
+TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTag(const FGameplayTag Tag, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+{
+	TArray<TWeakObjectPtr<UFlowComponent>> FoundComponents;
+	FindComponents(Tag, bExactMatch, FoundComponents);
+
+	TMap<AActor*, UFlowComponent*> Result;
+	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	{
+		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
+		{
+			Result.Emplace(Component->GetOwner(), Component.Get());
+		}
+	}
+
+	return Result;
+}
+
+TMap<AActor*, UFlowComponent*> UFlowSubsystem::GetFlowActorsAndComponentsByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const TSubclassOf<AActor> ActorClass, const bool bExactMatch) const
+{
+	TSet<TWeakObjectPtr<UFlowComponent>> FoundComponents;
+	FindComponents(Tags, MatchType, bExactMatch, FoundComponents);
+
+	TMap<AActor*, UFlowComponent*> Result;
+	for (const TWeakObjectPtr<UFlowComponent>& Component : FoundComponents)
+	{
+		if (Component.IsValid() && Component->GetOwner()->GetClass()->IsChildOf(ActorClass))
+		{
+			Result.Emplace(Component->GetOwner(), Component.Get());
+		}
+	}
+
+	return Result;
+}
+
+void UFlowSubsystem::RegisterComponentProxies(const TArray<FFlowComponentProxy>& Proxies)
+{
+	UnregisterComponentProxies();
+
+	ComponentProxies = Proxies;
+	for (int32 Index = 0; Index < ComponentProxies.Num(); Index++)
+	{
+		for (const FGameplayTag& Tag : ComponentProxies[Index].IdentityTags)
+		{
+			ProxyRegistry.Emplace(Tag, Index);
+		}
+		ProxyIndexByActorGuid.Emplace(ComponentProxies[Index].ActorGuid, Index);
+	}
+
+	// actors of cells loaded before proxies were registered
+	TArray<TWeakObjectPtr<UFlowComponent>> ComponentsArray;
+	FlowComponentRegistry.GenerateValueArray(ComponentsArray);
+	for (const TWeakObjectPtr<UFlowComponent>& Component : ComponentsArray)
+	{
+		const int32 ProxyIndex = Component.IsValid() ? FindProxyIndex(Component.Get()) : INDEX_NONE;
+		if (ProxyIndex != INDEX_NONE)
+		{
+			LoadedProxies.Add(ProxyIndex);
+		}
+	}
+}
+
+void UFlowSubsystem::UnregisterComponentProxies()
+{
+	if (QueuedNotifies.Num() > 0)
+	{
+		UE_LOG(LogFlow, Verbose, TEXT("Discarding notifies queued for %d actors that never streamed in"), QueuedNotifies.Num());
+	}
+
+	ComponentProxies.Empty();
+	ProxyRegistry.Empty();
+	ProxyIndexByActorGuid.Empty();
+	LoadedProxies.Empty();
+	QueuedNotifies.Empty();
+}
+
+TArray<FFlowComponentProxy> UFlowSubsystem::GetComponentProxiesByTag(const FGameplayTag Tag, const bool bOnlyUnloaded, const bool bExactMatch) const
+{
+	return GetComponentProxiesByTags(FGameplayTagContainer(Tag), EGameplayContainerMatchType::Any, bOnlyUnloaded, bExactMatch);
+}
+
+TArray<FFlowComponentProxy> UFlowSubsystem::GetComponentProxiesByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const bool bOnlyUnloaded, const bool bExactMatch) const
+{
+	TArray<int32> ProxyIndices;
+	FindProxies(Tags, MatchType, bExactMatch, bOnlyUnloaded, ProxyIndices);
+
+	TArray<FFlowComponentProxy> Result;
+	Result.Reserve(ProxyIndices.Num());
+	for (const int32 Index : ProxyIndices)
+	{
+		Result.Emplace(ComponentProxies[Index]);
+	}
+
+	return Result;
+}
+
+int32 UFlowSubsystem::QueueNotifyForUnloadedActors(const FGameplayTagContainer& IdentityTags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, const FGameplayTagContainer& NotifyTags, UFlowComponent* Sender, const bool bFromGraph, const EFlowNetMode NetMode /* = EFlowNetMode::Authority*/)
+{
+	if (ComponentProxies.Num() == 0 || !NotifyTags.IsValid())
+	{
+		return 0;
+	}
+
+	TArray<int32> ProxyIndices;
+	FindProxies(IdentityTags, MatchType, bExactMatch, true, ProxyIndices);
+
+	const int32 MaxQueuedNotifies = FMath::Max(1, UFlowSettings::Get()->MaxQueuedNotifiesPerActor);
+	for (const int32 Index : ProxyIndices)
+	{
+		TArray<FFlowQueuedNotify>& ActorNotifies = QueuedNotifies.FindOrAdd(Index);
+		if (ActorNotifies.Num() >= MaxQueuedNotifies)
+		{
+			UE_LOG(LogFlow, Verbose, TEXT("Discarding the oldest notify queued for %s, limit of queued notifies reached"), *ComponentProxies[Index].Actor.ToString());
+			ActorNotifies.RemoveAt(0);
+		}
+		ActorNotifies.Emplace(Sender, NotifyTags, bFromGraph, NetMode);
+	}
+
+	return ProxyIndices.Num();
+}
+
+int32 UFlowSubsystem::FindProxyIndex(const UFlowComponent* Component) const
+{
+	// Proxy Guid is assigned by the commandlet generating proxies, components without proxy have it invalid
+	if (!Component->ProxyGuid.IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32* ProxyIndex = ProxyIndexByActorGuid.Find(Component->ProxyGuid);
+	return ProxyIndex ? *ProxyIndex : INDEX_NONE;
+}
+
+void UFlowSubsystem::FindProxies(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, const bool bOnlyUnloaded, TArray<int32>& OutProxyIndices) const
+{
+	TSet<int32> Candidates;
+	for (const FGameplayTag& Tag : Tags)
+	{
+		if (bExactMatch)
+		{
+			TArray<int32> ProxiesWithTag;
+			ProxyRegistry.MultiFind(Tag, ProxiesWithTag);
+			Candidates.Append(ProxiesWithTag);
+		}
+		else
+		{
+			for (TMultiMap<FGameplayTag, int32>::TConstIterator It(ProxyRegistry); It; ++It)
+			{
+				if (It.Key().MatchesTag(Tag))
+				{
+					Candidates.Emplace(It.Value());
+				}
+			}
+		}
+	}
+
+	for (const int32 Index : Candidates)
+	{
+		const FFlowComponentProxy& Proxy = ComponentProxies[Index];
+		if (MatchType == EGameplayContainerMatchType::All && !(bExactMatch ? Proxy.IdentityTags.HasAllExact(Tags) : Proxy.IdentityTags.HasAll(Tags)))
+		{
+			continue;
+		}
+
+		if (!bOnlyUnloaded || !IsProxyLoaded(Index))
+		{
+			OutProxyIndices.Emplace(Index);
+		}
+	}
+}
+
+void UFlowSubsystem::DeliverQueuedNotifies(UFlowComponent* Component)
+{
+	const int32 ProxyIndex = FindProxyIndex(Component);
+	TArray<FFlowQueuedNotify> Notifies;
+	if (ProxyIndex == INDEX_NONE || !QueuedNotifies.RemoveAndCopyValue(ProxyIndex, Notifies))
+	{
+		return;
+	}
+
+	const bool bReplicate = Component->IsNetMode(NM_DedicatedServer) || Component->IsNetMode(NM_ListenServer);
+	for (const FFlowQueuedNotify& Notify : Notifies)
+	{
+		if (Notify.bFromGraph)
+		{
+			Component->NotifyFromGraph(Notify.NotifyTags, Notify.NetMode);
+			continue;
+		}
+
+		for (const FGameplayTag& NotifyTag : Notify.NotifyTags)
+		{
+			Component->ReceiveNotify.Broadcast(Notify.Sender.Get(), NotifyTag);
+			if (bReplicate)
+			{
+				Component->ReplicateNotifyFromAnotherComponent(Notify.Sender.Get(), NotifyTag);
+			}
+		}
+	}
+}
+
+void UFlowSubsystem::RecordRecentNotifies(UFlowComponent* Component, const FGameplayTagContainer& NotifyTags)
+{
+	if (!IsIndexingRecentNotifies())
+	{
+		return;
+	}
+
+	const double CurrentTime = GetRecentNotifyTime();
+	const double OldestValidTime = CurrentTime - UFlowSettings::Get()->RecentNotifyRetention;
+
+	for (const FGameplayTag& NotifyTag : NotifyTags)
+	{
+		TArray<FFlowRecentNotify>& Notifies = RecentNotifies.FindOrAdd(NotifyTag);
+
+		// keep only the latest notify per component, array stays sorted by time
+		Notifies.RemoveAll([Component, OldestValidTime](const FFlowRecentNotify& Notify)
+		{
+			return Notify.Time < OldestValidTime || !Notify.Component.IsValid() || Notify.Component == Component;
+		});
+		Notifies.Emplace(Component, CurrentTime);
+	}
+}
+
+void UFlowSubsystem::PruneRecentNotifies()
+{
+	const double OldestValidTime = GetRecentNotifyTime() - UFlowSettings::Get()->RecentNotifyRetention;
+
+	for (auto It = RecentNotifies.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAll([OldestValidTime](const FFlowRecentNotify& Notify)
+		{
+			return Notify.Time < OldestValidTime || !Notify.Component.IsValid();
+		});
+
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+double UFlowSubsystem::GetRecentNotifyTime() const
+{
+	return GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+}
+
+bool UFlowSubsystem::IsIndexingRecentNotifies() const
+{
+	return UFlowSettings::Get()->RecentNotifyRetention > 0.0f;
+}
+
+void UFlowSubsystem::FindRecentNotifySenders(const FGameplayTagContainer& NotifyTags, const FGameplayTagContainer& IdentityTags, const EFlowTagContainerMatchType MatchType, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+{
+	const double OldestValidTime = GetRecentNotifyTime() - UFlowSettings::Get()->RecentNotifyRetention;
+
+	for (const FGameplayTag& NotifyTag : NotifyTags)
+	{
+		if (const TArray<FFlowRecentNotify>* Notifies = RecentNotifies.Find(NotifyTag))
+		{
+			// iterate from the latest notify, we can stop on the first expired one
+			for (int32 i = Notifies->Num() - 1; i >= 0; i--)
+			{
+				const FFlowRecentNotify& Notify = (*Notifies)[i];
+				if (Notify.Time < OldestValidTime)
+				{
+					break;
+				}
+
+				if (Notify.Component.IsValid() && FlowTypes::HasMatchingTags(Notify.Component->IdentityTags, IdentityTags, MatchType))
+				{
+					OutComponents.Emplace(Notify.Component);
+				}
+			}
+		}
+	}
+}
+
+void UFlowSubsystem::FindComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+{
+	// exact match is a single lookup already, only scanning the whole registry is worth remembering
+	if (bExactMatch || UFlowSettings::Get()->ComponentQueryCacheSize == 0)
+	{
+		CollectComponents(Tag, bExactMatch, OutComponents);
+	}
+	else
+	{
+		OutComponents.Append(FindCachedComponents(FGameplayTagContainer(Tag), EGameplayContainerMatchType::Any, bExactMatch).Array());
+	}
+}
+
+void UFlowSubsystem::FindComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+{
+	if (UFlowSettings::Get()->ComponentQueryCacheSize == 0)
+	{
+		CollectComponents(Tags, MatchType, bExactMatch, OutComponents);
+	}
+	else
+	{
+		OutComponents.Append(FindCachedComponents(Tags, MatchType, bExactMatch));
+	}
+}
+
+const TSet<TWeakObjectPtr<UFlowComponent>>& UFlowSubsystem::FindCachedComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch) const
+{
+	const FFlowComponentQueryKey QueryKey(Tags, MatchType, bExactMatch);
+	if (const TSet<TWeakObjectPtr<UFlowComponent>>* CachedComponents = ComponentQueryCache.Find(QueryKey))
+	{
+		return *CachedComponents;
+	}
+
+	// simply start over, queries used by active graphs will be remembered again
+	if (ComponentQueryCache.Num() >= UFlowSettings::Get()->ComponentQueryCacheSize)
+	{
+		ComponentQueryCache.Reset();
+	}
+
+	TSet<TWeakObjectPtr<UFlowComponent>>& FoundComponents = ComponentQueryCache.Add(QueryKey);
+	CollectComponents(Tags, MatchType, bExactMatch, FoundComponents);
+	return FoundComponents;
+}
+
+void UFlowSubsystem::InvalidateComponentQueries(const FGameplayTagContainer& ChangedTags)
+{
+	for (auto It = ComponentQueryCache.CreateIterator(); It; ++It)
+	{
+		// non-exact query matches also children of queried tags
+		const bool bAffected = It.Key().bExactMatch ? ChangedTags.HasAnyExact(It.Key().Tags) : ChangedTags.HasAny(It.Key().Tags);
+		if (bAffected)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UFlowSubsystem::CollectComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
+{
+	if (bExactMatch)
+	{
+		FlowComponentRegistry.MultiFind(Tag, OutComponents);
+	}
+	else
+	{
+		for (TMultiMap<FGameplayTag, TWeakObjectPtr<UFlowComponent>>::TConstIterator It(FlowComponentRegistry); It; ++It)
+		{
+			if (It.Key().MatchesTag(Tag))
+			{
+				OutComponents.Emplace(It.Value());
+			}
+		}
+	}
+}
+
+void UFlowSubsystem::CollectComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const
 {
 	if (MatchType == EGameplayContainerMatchType::Any)
 	{
 		for (const FGameplayTag& Tag : Tags)
 		{
 			TArray<TWeakObjectPtr<UFlowComponent>> ComponentsPerTag;
-			FindComponents(Tag, bExactMatch, ComponentsPerTag);
+			CollectComponents(Tag, bExactMatch, ComponentsPerTag);
 			OutComponents.Append(ComponentsPerTag);
 		}
 	}
@@ -647,7 +1830,7 @@ void UFlowSubsystem::FindComponents(const FGameplayTagContainer& Tags, const EGa
 		for (const FGameplayTag& Tag : Tags)
 		{
 			TArray<TWeakObjectPtr<UFlowComponent>> ComponentsPerTag;
-			FindComponents(Tag, bExactMatch, ComponentsPerTag);
+			CollectComponents(Tag, bExactMatch, ComponentsPerTag);
 			ComponentsWithAnyTag.Append(ComponentsPerTag);
 		}
 
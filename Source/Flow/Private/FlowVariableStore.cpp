@@ -0,0 +1,209 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "FlowVariableStore.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowVariableStore)
+
+void FFlowVariableStore::Initialize(const TArray<FFlowVariableDesc>& Variables)
+{
+	LayoutHash = CalcLayoutHash(Variables);
+
+	Bools.Reset();
+	Ints.Reset();
+	Floats.Reset();
+	Names.Reset();
+	Strings.Reset();
+	GameplayTags.Reset();
+
+	for (const FFlowVariableDesc& Variable : Variables)
+	{
+		switch (Variable.Type)
+		{
+			case EFlowVariableType::Bool:
+				Bools.Add(Variable.DefaultValue.ToBool());
+				break;
+			case EFlowVariableType::Int:
+				Ints.Add(FCString::Atoi(*Variable.DefaultValue));
+				break;
+			case EFlowVariableType::Float:
+				Floats.Add(FCString::Atof(*Variable.DefaultValue));
+				break;
+			case EFlowVariableType::Name:
+				Names.Add(*Variable.DefaultValue);
+				break;
+			case EFlowVariableType::String:
+				Strings.Add(Variable.DefaultValue);
+				break;
+			case EFlowVariableType::GameplayTag:
+				GameplayTags.Add(FGameplayTag::RequestGameplayTag(*Variable.DefaultValue, false));
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+bool FFlowVariableStore::MatchesLayout(const TArray<FFlowVariableDesc>& Variables) const
+{
+	return LayoutHash == CalcLayoutHash(Variables);
+}
+
+uint32 FFlowVariableStore::CalcLayoutHash(const TArray<FFlowVariableDesc>& Variables)
+{
+	// names compare case-insensitive, while the case of the FName string depends on which instance was created first
+	uint32 Hash = 0;
+	for (const FFlowVariableDesc& Variable : Variables)
+	{
+		Hash = FCrc::StrCrc32(*Variable.Name.ToString().ToLower(), Hash);
+		Hash = HashCombine(Hash, static_cast<uint32>(Variable.Type));
+	}
+	return Hash;
+}
+
+void FFlowVariableStore::ResolveReference(const TArray<FFlowVariableDesc>& Variables, FFlowVariableReference& Reference)
+{
+	Reference.Index = INDEX_NONE;
+	if (Reference.Name.IsNone())
+	{
+		return;
+	}
+
+	int32 NumPerType[static_cast<uint8>(EFlowVariableType::MAX)] = {0};
+	for (const FFlowVariableDesc& Variable : Variables)
+	{
+		const uint8 TypeIndex = static_cast<uint8>(Variable.Type);
+		if (Variable.Name == Reference.Name)
+		{
+			Reference.Type = Variable.Type;
+			Reference.Index = NumPerType[TypeIndex];
+			return;
+		}
+		NumPerType[TypeIndex]++;
+	}
+}
+
+bool FFlowVariableStore::GetBool(const FFlowVariableReference& Variable) const
+{
+	return IsValidSlot(Bools, Variable, EFlowVariableType::Bool) ? Bools[Variable.Index] : false;
+}
+
+int32 FFlowVariableStore::GetInt(const FFlowVariableReference& Variable) const
+{
+	return IsValidSlot(Ints, Variable, EFlowVariableType::Int) ? Ints[Variable.Index] : 0;
+}
+
+float FFlowVariableStore::GetFloat(const FFlowVariableReference& Variable) const
+{
+	return IsValidSlot(Floats, Variable, EFlowVariableType::Float) ? Floats[Variable.Index] : 0.0f;
+}
+
+FName FFlowVariableStore::GetName(const FFlowVariableReference& Variable) const
+{
+	return IsValidSlot(Names, Variable, EFlowVariableType::Name) ? Names[Variable.Index] : NAME_None;
+}
+
+const FString& FFlowVariableStore::GetString(const FFlowVariableReference& Variable) const
+{
+	static const FString EmptyString;
+	return IsValidSlot(Strings, Variable, EFlowVariableType::String) ? Strings[Variable.Index] : EmptyString;
+}
+
+FGameplayTag FFlowVariableStore::GetGameplayTag(const FFlowVariableReference& Variable) const
+{
+	return IsValidSlot(GameplayTags, Variable, EFlowVariableType::GameplayTag) ? GameplayTags[Variable.Index] : FGameplayTag::EmptyTag;
+}
+
+void FFlowVariableStore::SetBool(const FFlowVariableReference& Variable, const bool bValue)
+{
+	if (IsValidSlot(Bools, Variable, EFlowVariableType::Bool))
+	{
+		Bools[Variable.Index] = bValue;
+	}
+}
+
+void FFlowVariableStore::SetInt(const FFlowVariableReference& Variable, const int32 Value)
+{
+	if (IsValidSlot(Ints, Variable, EFlowVariableType::Int))
+	{
+		Ints[Variable.Index] = Value;
+	}
+}
+
+void FFlowVariableStore::SetFloat(const FFlowVariableReference& Variable, const float Value)
+{
+	if (IsValidSlot(Floats, Variable, EFlowVariableType::Float))
+	{
+		Floats[Variable.Index] = Value;
+	}
+}
+
+void FFlowVariableStore::SetName(const FFlowVariableReference& Variable, const FName& Value)
+{
+	if (IsValidSlot(Names, Variable, EFlowVariableType::Name))
+	{
+		Names[Variable.Index] = Value;
+	}
+}
+
+void FFlowVariableStore::SetString(const FFlowVariableReference& Variable, const FString& Value)
+{
+	if (IsValidSlot(Strings, Variable, EFlowVariableType::String))
+	{
+		Strings[Variable.Index] = Value;
+	}
+}
+
+void FFlowVariableStore::SetGameplayTag(const FFlowVariableReference& Variable, const FGameplayTag& Value)
+{
+	if (IsValidSlot(GameplayTags, Variable, EFlowVariableType::GameplayTag))
+	{
+		GameplayTags[Variable.Index] = Value;
+	}
+}
+
+SIZE_T FFlowVariableStore::GetAllocatedSize() const
+{
+	SIZE_T Size = Bools.GetAllocatedSize() + Ints.GetAllocatedSize() + Floats.GetAllocatedSize()
+		+ Names.GetAllocatedSize() + Strings.GetAllocatedSize() + GameplayTags.GetAllocatedSize();
+
+	for (const FString& String : Strings)
+	{
+		Size += String.GetAllocatedSize();
+	}
+	return Size;
+}
+
+bool FFlowVariableStore::Serialize(FArchive& Ar)
+{
+	Ar << LayoutHash;
+
+	Ar << Bools;
+	Ar << Ints;
+	Ar << Floats;
+	Ar << Names;
+	Ar << Strings;
+
+	// tags are stored by name, so saved data doesn't depend on tag table order
+	TArray<FName> TagNames;
+	if (Ar.IsSaving())
+	{
+		TagNames.Reserve(GameplayTags.Num());
+		for (const FGameplayTag& Tag : GameplayTags)
+		{
+			TagNames.Add(Tag.GetTagName());
+		}
+	}
+
+	Ar << TagNames;
+
+	if (Ar.IsLoading())
+	{
+		GameplayTags.Reset(TagNames.Num());
+		for (const FName& TagName : TagNames)
+		{
+			GameplayTags.Add(FGameplayTag::RequestGameplayTag(TagName, false));
+		}
+	}
+
+	return true;
+}
@@ -2,6 +2,10 @@
 
 #include "FlowWorldSettings.h"
 #include "FlowComponent.h"
+#include "FlowSubsystem.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowWorldSettings)
 
@@ -14,3 +18,29 @@ AFlowWorldSettings::AFlowWorldSettings(const FObjectInitializer& ObjectInitializ
 	// In this case engine would call BeginPlay multiple times... for AFlowWorldSettings and every inherited AWorldSettings class...
 	FlowComponent->bAllowMultipleInstances = false;
 }
+
+void AFlowWorldSettings::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ComponentProxies.Num() > 0 && GetWorld()->GetGameInstance())
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UFlowSubsystem>())
+		{
+			FlowSubsystem->RegisterComponentProxies(ComponentProxies);
+		}
+	}
+}
+
+void AFlowWorldSettings::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ComponentProxies.Num() > 0 && GetWorld()->GetGameInstance())
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UFlowSubsystem>())
+		{
+			FlowSubsystem->UnregisterComponentProxies();
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
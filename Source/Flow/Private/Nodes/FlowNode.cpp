@@ -3,6 +3,7 @@
 #include "Nodes/FlowNode.h"
 
 #include "FlowAsset.h"
+#include "FlowGroup.h"
 #include "FlowLogChannels.h"
 #include "FlowOwnerInterface.h"
 #include "FlowSettings.h"
@@ -22,6 +23,7 @@
 
 #if WITH_EDITOR
 #include "Editor.h"
+#include "Interfaces/ITargetPlatform.h"
 #endif
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode)
@@ -44,6 +46,7 @@ UFlowNode::UFlowNode(const FObjectInitializer& ObjectInitializer)
 #endif
 	, AllowedSignalModes({EFlowSignalMode::Enabled, EFlowSignalMode::Disabled, EFlowSignalMode::PassThrough})
 	, SignalMode(EFlowSignalMode::Enabled)
+	, CookTarget(EFlowCookTarget::All)
 	, bPreloaded(false)
 	, ActivationState(EFlowNodeState::NeverActivated)
 {
@@ -57,6 +60,32 @@ UFlowNode::UFlowNode(const FObjectInitializer& ObjectInitializer)
 	OutputPins = {DefaultOutputPin};
 }
 
+bool UFlowNode::IsEditorOnly() const
+{
+	return CookTarget == EFlowCookTarget::EditorOnly || Super::IsEditorOnly();
+}
+
+#if WITH_EDITOR
+bool UFlowNode::NeedsLoadForTargetPlatform(const ITargetPlatform* TargetPlatform) const
+{
+	// decided per cook platform, as Game target (standalone, listen server) is both client and server
+	if (TargetPlatform)
+	{
+		if (CookTarget == EFlowCookTarget::ServerOnly && TargetPlatform->IsClientOnly())
+		{
+			return false;
+		}
+
+		if (CookTarget == EFlowCookTarget::ClientOnly && TargetPlatform->IsServerOnly())
+		{
+			return false;
+		}
+	}
+
+	return Super::NeedsLoadForTargetPlatform(TargetPlatform);
+}
+#endif
+
 #if WITH_EDITOR
 void UFlowNode::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
@@ -181,6 +210,17 @@ AActor* UFlowNode::TryGetRootFlowActorOwner() const
 	return OwningActor;
 }
 
+UFlowGroup* UFlowNode::GetFlowGroup() const
+{
+	return Cast<UFlowGroup>(TryGetRootFlowObjectOwner());
+}
+
+FFlowVariableStore* UFlowNode::GetVariableStore() const
+{
+	UFlowAsset* FlowAsset = GetFlowAsset();
+	return FlowAsset ? &FlowAsset->GetVariableStore() : nullptr;
+}
+
 UObject* UFlowNode::TryGetRootFlowObjectOwner() const
 {
 	const UFlowAsset* FlowAsset = GetFlowAsset();
@@ -428,7 +468,11 @@ TSet<UFlowNode*> UFlowNode::GetConnectedNodes() const
 	TSet<UFlowNode*> Result;
 	for (const TPair<FName, FConnectedPin>& Connection : Connections)
 	{
-		Result.Emplace(GetFlowAsset()->GetNode(Connection.Value.NodeGuid));
+		// connected node might have been stripped from this cook
+		if (UFlowNode* ConnectedNode = GetFlowAsset()->GetNode(Connection.Value.NodeGuid))
+		{
+			Result.Emplace(ConnectedNode);
+		}
 	}
 	return Result;
 }
@@ -526,6 +570,18 @@ void UFlowNode::TriggerFlush()
 {
 	bPreloaded = false;
 	FlushContent();
+
+	if (PreloadedAssets.Num() > 0)
+	{
+		if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+		{
+			for (const FSoftObjectPath& AssetPath : PreloadedAssets)
+			{
+				FlowSubsystem->ReleasePreloadedContent(AssetPath);
+			}
+		}
+		PreloadedAssets.Empty();
+	}
 }
 
 void UFlowNode::PreloadContent()
@@ -538,6 +594,20 @@ void UFlowNode::FlushContent()
 	K2_FlushContent();
 }
 
+void UFlowNode::PreloadAsset(const FSoftObjectPath& AssetPath)
+{
+	if (AssetPath.IsNull())
+	{
+		return;
+	}
+
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		FlowSubsystem->AcquirePreloadedContent(AssetPath);
+		PreloadedAssets.Emplace(AssetPath);
+	}
+}
+
 void UFlowNode::OnActivate()
 {
 	K2_OnActivate();
@@ -720,10 +790,62 @@ void UFlowNode::ResetRecords()
 #endif
 }
 
+SIZE_T UFlowNode::GetRecordsAllocatedSize() const
+{
+	SIZE_T Result = 0;
+
+#if !UE_BUILD_SHIPPING
+	for (const TMap<FName, TArray<FPinRecord>>* Records : {&InputRecords, &OutputRecords})
+	{
+		Result += Records->GetAllocatedSize();
+		for (const TPair<FName, TArray<FPinRecord>>& PinRecords : *Records)
+		{
+			Result += PinRecords.Value.GetAllocatedSize();
+			for (const FPinRecord& Record : PinRecords.Value)
+			{
+				Result += Record.HumanReadableTime.GetAllocatedSize();
+			}
+		}
+	}
+#endif
+
+	return Result;
+}
+
+SIZE_T UFlowNode::CompactRecords()
+{
+	const SIZE_T SizeBeforeCompaction = GetRecordsAllocatedSize();
+
+#if !UE_BUILD_SHIPPING
+	// debugger only needs the latest record to draw recently executed wires
+	for (TMap<FName, TArray<FPinRecord>>* Records : {&InputRecords, &OutputRecords})
+	{
+		for (TPair<FName, TArray<FPinRecord>>& PinRecords : *Records)
+		{
+			if (PinRecords.Value.Num() > 1)
+			{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION > 3
+				PinRecords.Value.RemoveAt(0, PinRecords.Value.Num() - 1, EAllowShrinking::No);
+#else
+				PinRecords.Value.RemoveAt(0, PinRecords.Value.Num() - 1, false);
+#endif
+			}
+			PinRecords.Value.Shrink();
+		}
+		Records->Shrink();
+	}
+#endif
+
+	return SizeBeforeCompaction - GetRecordsAllocatedSize();
+}
+
 void UFlowNode::SaveInstance(FFlowNodeSaveData& NodeRecord)
 {
 	NodeRecord.NodeGuid = NodeGuid;
-	OnSave();
+	if (GetFlowSubsystem() == nullptr || !GetFlowSubsystem()->IsCapturingReplaySnapshot())
+	{
+		OnSave();
+	}
 
 	FMemoryWriter MemoryWriter(NodeRecord.NodeData, true);
 	FFlowArchive Ar(MemoryWriter);
@@ -159,6 +159,12 @@ TArray<FFlowPin> UFlowNode_SubGraph::GetContextOutputs()
 	return Pins;
 }
 
+bool UFlowNode_SubGraph::GetContextPinsDependencies(TArray<FSoftObjectPath>& OutAssets) const
+{
+	OutAssets.Add(Asset.ToSoftObjectPath());
+	return true;
+}
+
 void UFlowNode_SubGraph::PostLoad()
 {
 	Super::PostLoad();
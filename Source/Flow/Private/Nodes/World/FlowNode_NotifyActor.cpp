@@ -22,8 +22,11 @@ UFlowNode_NotifyActor::UFlowNode_NotifyActor(const FObjectInitializer& ObjectIni
 
 void UFlowNode_NotifyActor::ExecuteInput(const FName& PinName)
 {
-	if (const UFlowSubsystem* FlowSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UFlowSubsystem>())
+	if (UFlowSubsystem* FlowSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UFlowSubsystem>())
 	{
+		// actors in unloaded World Partition cells receive notify once they stream in
+		FlowSubsystem->QueueNotifyForUnloadedActors(IdentityTags, MatchType, bExactMatch, NotifyTags, nullptr, true, NetMode);
+
 		for (const TWeakObjectPtr<UFlowComponent>& Component : FlowSubsystem->GetComponents<UFlowComponent>(IdentityTags, MatchType, bExactMatch))
 		{
 			Component->NotifyFromGraph(NotifyTags, NetMode);
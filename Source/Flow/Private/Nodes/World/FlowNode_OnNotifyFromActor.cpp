@@ -2,6 +2,7 @@
 
 #include "Nodes/World/FlowNode_OnNotifyFromActor.h"
 #include "FlowComponent.h"
+#include "FlowSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_OnNotifyFromActor)
 
@@ -15,6 +16,30 @@ UFlowNode_OnNotifyFromActor::UFlowNode_OnNotifyFromActor(const FObjectInitialize
 #endif
 }
 
+void UFlowNode_OnNotifyFromActor::StartObserving()
+{
+	// single lookup in the subsystem index replaces inspecting every observed component
+	const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (bRetroactive && FlowSubsystem && FlowSubsystem->IsIndexingRecentNotifies())
+	{
+		TSet<TWeakObjectPtr<UFlowComponent>> RecentSenders;
+		FlowSubsystem->FindRecentNotifySenders(NotifyTags, IdentityTags, IdentityMatchType, RecentSenders);
+
+		for (int32 i = 0; i < RecentSenders.Num(); i++)
+		{
+			OnEventReceived();
+
+			// node might finish work immediately
+			if (GetActivationState() != EFlowNodeState::Active)
+			{
+				return;
+			}
+		}
+	}
+
+	Super::StartObserving();
+}
+
 void UFlowNode_OnNotifyFromActor::ObserveActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component)
 {
 	if (!RegisteredActors.Contains(Actor))
@@ -22,7 +47,10 @@ void UFlowNode_OnNotifyFromActor::ObserveActor(TWeakObjectPtr<AActor> Actor, TWe
 		RegisteredActors.Emplace(Actor, Component);
 		Component->OnNotifyFromComponent.AddUObject(this, &UFlowNode_OnNotifyFromActor::OnNotifyFromComponent);
 
-		if (bRetroactive && Component->GetRecentlySentNotifyTags().HasAnyExact(NotifyTags))
+		// fallback if subsystem doesn't index recent notifies
+		const UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+		const bool bIndexedRetroactiveCheck = FlowSubsystem && FlowSubsystem->IsIndexingRecentNotifies();
+		if (bRetroactive && !bIndexedRetroactiveCheck && Component->GetRecentlySentNotifyTags().HasAnyExact(NotifyTags))
 		{
 			OnEventReceived();
 		}
@@ -54,6 +54,12 @@ UFlowNode_PlayLevelSequence::UFlowNode_PlayLevelSequence(const FObjectInitialize
 }
 
 #if WITH_EDITOR
+bool UFlowNode_PlayLevelSequence::GetContextPinsDependencies(TArray<FSoftObjectPath>& OutAssets) const
+{
+	OutAssets.Add(Sequence.ToSoftObjectPath());
+	return true;
+}
+
 TArray<FFlowPin> UFlowNode_PlayLevelSequence::GetContextOutputs()
 {
 	if (Sequence.IsNull())
@@ -111,10 +117,8 @@ void UFlowNode_PlayLevelSequence::PreloadContent()
 	UE_VLOG(this, LogFlow, Log, TEXT("Preloading"));
 #endif
 
-	if (!Sequence.IsNull())
-	{
-		StreamableManager.RequestAsyncLoad({Sequence.ToSoftObjectPath()}, FStreamableDelegate());
-	}
+	// content is shared with other instances of this node, released by UFlowNode::TriggerFlush
+	PreloadAsset(Sequence.ToSoftObjectPath());
 }
 
 void UFlowNode_PlayLevelSequence::FlushContent()
@@ -122,11 +126,6 @@ void UFlowNode_PlayLevelSequence::FlushContent()
 #if ENABLE_VISUAL_LOG
 	UE_VLOG(this, LogFlow, Log, TEXT("Flushing preload"));
 #endif
-
-	if (!Sequence.IsNull())
-	{
-		StreamableManager.Unload(Sequence.ToSoftObjectPath());
-	}
 }
 
 void UFlowNode_PlayLevelSequence::InitializeInstance()
@@ -0,0 +1,230 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Nodes/World/FlowNode_WatchValue.h"
+#include "FlowComponent.h"
+#include "FlowWatchableInterface.h"
+
+#include "Components/ActorComponent.h"
+#include "UObject/UnrealType.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNode_WatchValue)
+
+UFlowNode_WatchValue::UFlowNode_WatchValue(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, bWatchFlowOwner(false)
+	, bTriggerIfAlreadyMatching(true)
+{
+#if WITH_EDITOR
+	Category = TEXT("World");
+	NodeStyle = EFlowNodeStyle::Condition;
+#endif
+}
+
+void UFlowNode_WatchValue::ExecuteInput(const FName& PinName)
+{
+	if (!bWatchFlowOwner)
+	{
+		Super::ExecuteInput(PinName);
+		return;
+	}
+
+	if (PinName == TEXT("Start"))
+	{
+		StartObserving();
+	}
+	else if (PinName == TEXT("Stop"))
+	{
+		TriggerOutput(TEXT("Stopped"), true);
+	}
+}
+
+void UFlowNode_WatchValue::OnLoad_Implementation()
+{
+	if (bWatchFlowOwner)
+	{
+		StartObserving();
+	}
+	else
+	{
+		Super::OnLoad_Implementation();
+	}
+}
+
+void UFlowNode_WatchValue::StartObserving()
+{
+	if (PropertyName.IsNone())
+	{
+		LogError(TEXT("Missing Property Name"));
+		return;
+	}
+
+	if (bWatchFlowOwner)
+	{
+		UObject* FlowOwner = TryGetRootFlowObjectOwner();
+		if (FlowOwner && FlowOwner->Implements<UFlowWatchableInterface>())
+		{
+			WatchObject(FlowOwner);
+		}
+		else
+		{
+			LogError(TEXT("Flow owner doesn't implement Flow Watchable Interface"));
+		}
+	}
+	else
+	{
+		Super::StartObserving();
+	}
+}
+
+void UFlowNode_WatchValue::StopObserving()
+{
+	Super::StopObserving();
+
+	for (const TPair<TWeakObjectPtr<UObject>, FString>& WatchedValue : WatchedValues)
+	{
+		if (IFlowWatchableInterface* Watchable = Cast<IFlowWatchableInterface>(WatchedValue.Key.Get()))
+		{
+			Watchable->GetOnWatchedValueChanged().RemoveAll(this);
+		}
+	}
+	WatchedValues.Empty();
+}
+
+void UFlowNode_WatchValue::ObserveActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component)
+{
+	if (!RegisteredActors.Contains(Actor))
+	{
+		RegisteredActors.Emplace(Actor, Component);
+		WatchObject(Component.Get());
+	}
+}
+
+void UFlowNode_WatchValue::ForgetActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component)
+{
+	ForgetObject(Component.Get());
+}
+
+void UFlowNode_WatchValue::WatchObject(UObject* Object)
+{
+	IFlowWatchableInterface* Watchable = Cast<IFlowWatchableInterface>(Object);
+	if (Watchable == nullptr || WatchedValues.Contains(Object))
+	{
+		return;
+	}
+
+	FString CurrentValue;
+	if (!ReadValue(Object, CurrentValue))
+	{
+		LogError(FString::Printf(TEXT("Property %s not found in %s"), *PropertyName.ToString(), *Object->GetName()));
+		return;
+	}
+
+	WatchedValues.Emplace(Object, CurrentValue);
+	Watchable->GetOnWatchedValueChanged().AddUObject(this, &UFlowNode_WatchValue::OnWatchedValueChanged);
+
+	if (bTriggerIfAlreadyMatching && !TargetValue.IsEmpty() && CurrentValue == TargetValue)
+	{
+		OnEventReceived();
+	}
+}
+
+void UFlowNode_WatchValue::ForgetObject(UObject* Object)
+{
+	if (IFlowWatchableInterface* Watchable = Cast<IFlowWatchableInterface>(Object))
+	{
+		Watchable->GetOnWatchedValueChanged().RemoveAll(this);
+	}
+
+	WatchedValues.Remove(Object);
+}
+
+void UFlowNode_WatchValue::OnWatchedValueChanged(UObject* Source, const FName& ValueName)
+{
+	if (!ValueName.IsNone() && ValueName != PropertyName)
+	{
+		return;
+	}
+
+	FString* LastValue = WatchedValues.Find(Source);
+	FString NewValue;
+	if (LastValue == nullptr || !ReadValue(Source, NewValue) || NewValue == *LastValue)
+	{
+		return;
+	}
+
+	// store before triggering output, as node might finish work and clear watched values
+	*LastValue = NewValue;
+
+	if (TargetValue.IsEmpty() || NewValue == TargetValue)
+	{
+		OnEventReceived();
+	}
+}
+
+bool UFlowNode_WatchValue::ReadValue(const UObject* Source, FString& OutValue) const
+{
+	if (Source == nullptr)
+	{
+		return false;
+	}
+
+	const UObject* Container = Source;
+	const FProperty* Property = Source->GetClass()->FindPropertyByName(PropertyName);
+
+	// property might be declared on the actor owning the watched component
+	if (Property == nullptr)
+	{
+		if (const UActorComponent* Component = Cast<UActorComponent>(Source))
+		{
+			Container = Component->GetOwner();
+			Property = Container ? Container->GetClass()->FindPropertyByName(PropertyName) : nullptr;
+		}
+	}
+
+	if (Property)
+	{
+		OutValue.Reset();
+		Property->ExportTextItem_Direct(OutValue, Property->ContainerPtrToValuePtr<void>(Container), nullptr, nullptr, PPF_None);
+		return true;
+	}
+
+	return false;
+}
+
+void UFlowNode_WatchValue::Cleanup()
+{
+	StopObserving();
+
+	Super::Cleanup();
+}
+
+#if WITH_EDITOR
+FString UFlowNode_WatchValue::GetNodeDescription() const
+{
+	const FString WatchedObject = bWatchFlowOwner ? TEXT("Flow Owner") : GetIdentityTagsDescription(IdentityTags);
+	const FString Condition = TargetValue.IsEmpty() ? TEXT("any change") : TEXT("== ") + TargetValue;
+
+	return WatchedObject + LINE_TERMINATOR + PropertyName.ToString() + TEXT(" ") + Condition;
+}
+
+EDataValidationResult UFlowNode_WatchValue::ValidateNode()
+{
+	if (PropertyName.IsNone())
+	{
+		ValidationLog.Error<UFlowNode>(TEXT("Missing Property Name"), this);
+		return EDataValidationResult::Invalid;
+	}
+
+	return bWatchFlowOwner ? EDataValidationResult::Valid : Super::ValidateNode();
+}
+
+FString UFlowNode_WatchValue::GetStatusString() const
+{
+	if (ActivationState == EFlowNodeState::Active && bWatchFlowOwner && WatchedValues.Num() == 0)
+	{
+		return TEXT("Flow owner isn't watched");
+	}
+
+	return Super::GetStatusString();
+}
+#endif
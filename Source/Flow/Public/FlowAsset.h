@@ -4,6 +4,7 @@
 
 #include "FlowSave.h"
 #include "FlowTypes.h"
+#include "FlowVariableStore.h"
 #include "Nodes/FlowNode.h"
 
 #if WITH_EDITOR
@@ -76,6 +77,8 @@ public:
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 	virtual void PostDuplicate(bool bDuplicateForPIE) override;
 	virtual void PostLoad() override;
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+	virtual void PostSave(FObjectPostSaveContext ObjectSaveContext) override;
 	// --
 
 	virtual EDataValidationResult ValidateAsset(FFlowMessageLog& MessageLog);
@@ -83,6 +86,9 @@ public:
 	// Returns whether the node class is allowed in this flow asset
 	bool IsNodeClassAllowed(const UClass* FlowNodeClass, FText* OutOptionalFailureReason = nullptr) const;
 
+	// Inlined graph has no instance of its own, so it can't be inlined if it relies on one
+	bool CanBeInlined(FString* OutOptionalFailureReason = nullptr) const;
+
 	static FString ValidationError_NodeClassNotAllowed;
 	static FString ValidationError_NullNodeInstance;
 
@@ -127,6 +133,10 @@ private:
 	UPROPERTY()
 	TMap<FGuid, UFlowNode*> Nodes;
 
+	// Routing of nodes that might be stripped from the cooked build, see UFlowNode::CookTarget
+	UPROPERTY()
+	TMap<FGuid, FFlowPassThroughConnections> StrippedNodeConnections;
+
 #if WITH_EDITORONLY_DATA
 protected:
 	/**
@@ -142,6 +152,23 @@ protected:
 	 */
 	UPROPERTY(EditAnywhere, Category = "Sub Graph")
 	TArray<FName> CustomOutputs;
+
+	/**
+	 * While cooking, copy nodes of this graph into every graph using it via Sub Graph node, so no separate instance is created at runtime
+	 * Intended for small utility graphs used many times. Only graphs made entirely of node classes opting in via UFlowNode::CanBeInlined are inlined,
+	 * and only if they don't declare Parameters or Variables and aren't limited by Instance Quota. Neither are Sub Graph nodes providing Parameter Values
+	 * Inlined nodes are saved as part of the parent graph, so SaveGame data of such graph differs from the one of separate instance
+	 */
+	UPROPERTY(EditAnywhere, Category = "Sub Graph")
+	bool bInlineOnCook;
+
+private:
+	// Editor state restored after cooking, inlining Sub Graphs and sorting nodes must not modify the asset edited by user
+	TMap<FGuid, UFlowNode*> NodesBeforeCook;
+	TMap<UFlowNode*, TMap<FName, FConnectedPin>> ConnectionsBeforeInlining;
+
+	// Packages of Sub Graphs inlined while cooking, declared as cook dependencies
+	TArray<FName> InlinedSubGraphPackages;
 #endif // WITH_EDITORONLY_DATA
 
 public:
@@ -155,6 +182,18 @@ public:
 
 	// Processes all nodes and creates map of all pin connections
 	void HarvestNodeConnections();
+
+protected:
+	// Stores connections of nodes that aren't cooked for every target, so execution can pass through them
+	void HarvestStrippedNodeConnections();
+
+	// Replaces Sub Graph nodes using assets with bInlineOnCook by copies of their nodes, with GUIDs derived from the Sub Graph node
+	void InlineSubGraphs();
+
+	// Reverts inlining and order of nodes changed while cooking
+	void RestoreNodesBeforeCook();
+
+public:
 #endif
 
 	const TMap<FGuid, UFlowNode*>& GetNodes() const { return Nodes; }
@@ -384,6 +423,90 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Flow", meta = (MustImplement = "/Script/Flow.FlowOwnerInterface"))
 	TSubclassOf<UObject> ExpectedOwnerClass;
 
+//////////////////////////////////////////////////////////////////////////
+// Memory budget
+
+protected:
+	// Estimated memory (in kilobytes) the instance of this asset can use before its state gets compacted
+	// Set it to 0, if you want to use InstanceMemoryBudget from Flow Settings
+	UPROPERTY(EditAnywhere, Category = "Memory", meta = (ClampMin = 0, Units = "Kilobytes"))
+	int32 MemoryBudgetOverride;
+
+	// Limits number of instances of this asset running at the same time, including Sub Graphs
+	UPROPERTY(EditAnywhere, Category = "Quota")
+	FFlowInstanceQuota InstanceQuota;
+
+	// Set while initializing instance, used to find the oldest instance if quota evicts it
+	double InstanceCreationTime;
+
+public:
+	// Returns memory budget in bytes, 0 means instance won't be compacted automatically
+	int64 GetInstanceMemoryBudget() const;
+
+	const FFlowInstanceQuota& GetInstanceQuota() const { return InstanceQuota; }
+	double GetInstanceCreationTime() const { return InstanceCreationTime; }
+	const TArray<UFlowAsset*>& GetActiveInstances() const { return ActiveInstances; }
+
+	// Rough estimate of memory used by the runtime state of this instance
+	SIZE_T GetInstanceMemoryUsage() const;
+
+	// Releases finished SubGraphs bookkeeping, stale entries and debug records
+	// Returns number of reclaimed bytes
+	virtual SIZE_T CompactInstance();
+
+//////////////////////////////////////////////////////////////////////////
+// Parameters
+
+protected:
+	// Node properties which values can be provided per instance or per Flow Asset Variant
+	// Allows using a single graph instead of many assets differing only in node properties
+	UPROPERTY(EditAnywhere, Category = "Parameters")
+	TArray<FFlowAssetParameter> Parameters;
+
+	// Values provided for this instance, saved so restored instance gets the same values
+	UPROPERTY(SaveGame)
+	TMap<FName, FString> ParameterValues;
+
+public:
+	const TArray<FFlowAssetParameter>& GetParameters() const { return Parameters; }
+	const TMap<FName, FString>& GetParameterValues() const { return ParameterValues; }
+
+	void SetParameterValues(const TMap<FName, FString>& InParameterValues) { ParameterValues = InParameterValues; }
+
+protected:
+	// Imports parameter values into bound properties of node instances
+	void ApplyParameters();
+
+//////////////////////////////////////////////////////////////////////////
+// Variables
+
+protected:
+	// State shared by nodes of the instance, accessed via FFlowVariableReference properties on nodes
+	UPROPERTY(EditAnywhere, Category = "Variables")
+	TArray<FFlowVariableDesc> Variables;
+
+	UPROPERTY(SaveGame)
+	FFlowVariableStore VariableStore;
+
+public:
+	const TArray<FFlowVariableDesc>& GetVariables() const { return Variables; }
+
+	FFlowVariableStore& GetVariableStore() { return VariableStore; }
+	const FFlowVariableStore& GetVariableStore() const { return VariableStore; }
+
+#if WITH_EDITOR
+	// Resolves FFlowVariableReference properties of all nodes to slots of the variable store
+	// Node properties are visited recursively: nested structs, arrays and map values. References in sets or instanced objects aren't supported
+	// Unresolved and unsupported references are reported to the message log, if provided
+	void ResolveVariableReferences(FFlowMessageLog* MessageLog = nullptr);
+
+protected:
+	void ResolveVariableReferencesInStruct(const UStruct* Struct, void* Container, UFlowNode* Node, FFlowMessageLog* MessageLog);
+	void ResolveVariableReferencesInValue(const FProperty* Property, void* Value, UFlowNode* Node, FFlowMessageLog* MessageLog);
+
+public:
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 // SaveGame support
 
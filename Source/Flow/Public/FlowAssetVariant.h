@@ -0,0 +1,26 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "FlowAssetVariant.generated.h"
+
+class UFlowAsset;
+
+/**
+ * Lightweight asset providing parameter values for the shared Flow Asset
+ * Replaces near-duplicate Flow Assets differing only in node properties, i.e. target tags or timer durations
+ * Start it with UFlowSubsystem::StartRootFlowVariant
+ */
+UCLASS(BlueprintType)
+class FLOW_API UFlowAssetVariant : public UDataAsset
+{
+	GENERATED_UCLASS_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Variant")
+	TSoftObjectPtr<UFlowAsset> FlowAsset;
+
+	// Values of parameters declared in the Flow Asset, parameters not listed here use their default values
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Variant")
+	TMap<FName, FString> ParameterValues;
+};
@@ -8,26 +8,32 @@
 #include "FlowSave.h"
 #include "FlowTypes.h"
 #include "FlowOwnerInterface.h"
+#include "FlowWatchableInterface.h"
 #include "FlowComponent.generated.h"
 
 class UFlowAsset;
 class UFlowSubsystem;
 
+// Notify sent to this component by another Flow Component, replicated only to connections where the receiving actor is relevant
 USTRUCT()
 struct FNotifyTagReplication
 {
 	GENERATED_BODY()
 
+	// Might be null on clients, if sender isn't relevant to the connection
 	UPROPERTY()
-	FGameplayTag ActorTag;
+	class UFlowComponent* Sender;
 
 	UPROPERTY()
 	FGameplayTag NotifyTag;
 
-	FNotifyTagReplication() {}
+	FNotifyTagReplication()
+		: Sender(nullptr)
+	{
+	}
 
-	FNotifyTagReplication(const FGameplayTag& InActorTag, const FGameplayTag& InNotifyTag)
-		: ActorTag(InActorTag)
+	FNotifyTagReplication(class UFlowComponent* InSender, const FGameplayTag& InNotifyTag)
+		: Sender(InSender)
 		, NotifyTag(InNotifyTag)
 	{
 	}
@@ -42,7 +48,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFlowComponentDynamicNotify, class
 * Base component of Flow System - makes possible to communicate between Actor, Flow Subsystem and Flow Graphs
 */
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent))
-class FLOW_API UFlowComponent : public UActorComponent, public IFlowOwnerInterface
+class FLOW_API UFlowComponent : public UActorComponent, public IFlowOwnerInterface, public IFlowWatchableInterface
 {
 	GENERATED_UCLASS_BODY()
 
@@ -56,6 +62,11 @@ class FLOW_API UFlowComponent : public UActorComponent, public IFlowOwnerInterfa
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Flow")
 	FGameplayTagContainer IdentityTags;
 
+	// Identifies this component among Flow World Settings proxies, written by FlowRegistryProxy commandlet
+	// Actor Guid can't be used for that, it's available only in the editor
+	UPROPERTY(VisibleAnywhere, AdvancedDisplay, NonPIEDuplicateTransient, Category = "Flow")
+	FGuid ProxyGuid;
+
 private:
 	// Used to replicate tags added during gameplay
 	UPROPERTY(ReplicatedUsing = OnRep_AddedIdentityTags)
@@ -157,19 +168,36 @@ public:
 // Sending Notify Tags between Flow components
 
 private:
-	// Stores only recently replicated tags
+	// Stores only notifies received in the recent frame, replicated by the receiving component
 	UPROPERTY(ReplicatedUsing = OnRep_NotifyTagsFromAnotherComponent)
 	TArray<FNotifyTagReplication> NotifyTagsFromAnotherComponent;
 
+	uint64 NotifyTagsFromAnotherComponentFrame;
+
 public:
 	// Send notification to another actor containing Flow Component
 	UFUNCTION(BlueprintCallable, Category = "Flow")
 	virtual void NotifyActor(const FGameplayTag ActorTag, const FGameplayTag NotifyTag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
 
 private:
+	void ReplicateNotifyFromAnotherComponent(UFlowComponent* Sender, const FGameplayTag& NotifyTag);
+
 	UFUNCTION()
 	void OnRep_NotifyTagsFromAnotherComponent();
 
+//////////////////////////////////////////////////////////////////////////
+// Watched values
+
+public:
+	// Call this after changing a property of this component or its actor, so Watch Value nodes can react without polling
+	// Passing None will make every Watch Value node re-check its value
+	UFUNCTION(BlueprintCallable, Category = "Flow")
+	void NotifyValueChanged(const FName ValueName);
+
+	virtual FFlowWatchedValueChanged& GetOnWatchedValueChanged() override { return OnWatchedValueChanged; }
+
+	FFlowWatchedValueChanged OnWatchedValueChanged;
+
 //////////////////////////////////////////////////////////////////////////
 // Root Flow
 
@@ -178,6 +206,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RootFlow")
 	UFlowAsset* RootFlow;
 
+	// Values of parameters declared in the Root Flow asset, parameters not listed here use their default values
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RootFlow")
+	TMap<FName, FString> RootFlowParameters;
+
 	// If true, component will start Root Flow on Begin Play
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RootFlow")
 	bool bAutoStartRootFlow;
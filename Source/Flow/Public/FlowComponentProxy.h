@@ -0,0 +1,66 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "GameplayTagContainer.h"
+#include "Misc/Guid.h"
+
+#include "FlowTypes.h"
+
+#include "FlowComponentProxy.generated.h"
+
+/**
+ * Lightweight registry entry of the Flow Component placed in World Partition cell
+ * Generated in the editor and cooked with the world, so actor can be found before its cell is loaded
+ */
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowComponentProxy
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flow")
+	FGameplayTagContainer IdentityTags;
+
+	// Copied to Proxy Guid of the Flow Component, so the loaded component can find its proxy
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flow")
+	FGuid ActorGuid;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flow")
+	FVector Location;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Flow")
+	TSoftObjectPtr<AActor> Actor;
+
+	FFlowComponentProxy()
+		: Location(FVector::ZeroVector)
+	{
+	}
+
+	FFlowComponentProxy(const FGameplayTagContainer& InIdentityTags, const FGuid& InActorGuid, const FVector& InLocation, const TSoftObjectPtr<AActor>& InActor)
+		: IdentityTags(InIdentityTags)
+		, ActorGuid(InActorGuid)
+		, Location(InLocation)
+		, Actor(InActor)
+	{
+	}
+};
+
+// Notify sent to actor that wasn't loaded yet, delivered once it streams in
+struct FFlowQueuedNotify
+{
+	TWeakObjectPtr<class UFlowComponent> Sender;
+	FGameplayTagContainer NotifyTags;
+
+	// Notify sent by the Notify Actor node is delivered as notify from graph
+	bool bFromGraph;
+	EFlowNetMode NetMode;
+
+	FFlowQueuedNotify(const TWeakObjectPtr<class UFlowComponent> InSender, const FGameplayTagContainer& InNotifyTags, const bool bInFromGraph, const EFlowNetMode InNetMode)
+		: Sender(InSender)
+		, NotifyTags(InNotifyTags)
+		, bFromGraph(bInFromGraph)
+		, NetMode(InNetMode)
+	{
+	}
+};
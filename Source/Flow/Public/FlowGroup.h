@@ -0,0 +1,91 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "UObject/Object.h"
+#include "FlowGroup.generated.h"
+
+class AActor;
+class UFlowComponent;
+class UFlowSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFlowGroupMemberEvent, class UFlowGroup*, Group, AActor*, Member);
+
+/**
+ * Owner of the single Root Flow driving many actors, i.e. squad, crowd or spawn wave
+ * Actors with Flow Component having any of Member Tags join and leave the group automatically
+ * Nodes access the group via UFlowNode::GetFlowGroup()
+ */
+UCLASS(BlueprintType)
+class FLOW_API UFlowGroup : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+	friend class UFlowSubsystem;
+
+protected:
+	/* Identity Tags of Flow Components joining the group, exact match */
+	UPROPERTY(BlueprintReadOnly, Category = "FlowGroup")
+	FGameplayTagContainer MemberTags;
+
+	/* Optional object created for every member, keeping per-member state used by nodes */
+	UPROPERTY(BlueprintReadOnly, Category = "FlowGroup")
+	TSubclassOf<UObject> MemberContextClass;
+
+	UPROPERTY()
+	TArray<TWeakObjectPtr<AActor>> Members;
+
+	UPROPERTY()
+	TMap<TWeakObjectPtr<AActor>, UObject*> MemberContexts;
+
+public:
+	UPROPERTY(BlueprintAssignable, Category = "FlowGroup")
+	FFlowGroupMemberEvent OnMemberJoined;
+
+	UPROPERTY(BlueprintAssignable, Category = "FlowGroup")
+	FFlowGroupMemberEvent OnMemberLeft;
+
+	virtual UWorld* GetWorld() const override;
+
+	UFUNCTION(BlueprintCallable, Category = "FlowGroup")
+	virtual void AddMember(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "FlowGroup")
+	virtual void RemoveMember(AActor* Actor);
+
+	UFUNCTION(BlueprintPure, Category = "FlowGroup")
+	bool IsMember(const AActor* Actor) const;
+
+	UFUNCTION(BlueprintPure, Category = "FlowGroup")
+	TArray<AActor*> GetMembers() const;
+
+	UFUNCTION(BlueprintPure, Category = "FlowGroup")
+	int32 GetNumMembers() const { return Members.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "FlowGroup", meta = (DeterminesOutputType = "ContextClass"))
+	UObject* GetMemberContext(AActor* Actor, const TSubclassOf<UObject> ContextClass) const;
+
+	const FGameplayTagContainer& GetMemberTags() const { return MemberTags; }
+
+protected:
+	void StartTrackingMembers(UFlowSubsystem* FlowSubsystem);
+	void StopTrackingMembers(UFlowSubsystem* FlowSubsystem);
+
+	bool MatchesMemberTags(const UFlowComponent* Component) const;
+
+	UFUNCTION()
+	void OnComponentRegistered(UFlowComponent* Component);
+
+	UFUNCTION()
+	void OnComponentTagAdded(UFlowComponent* Component, const FGameplayTagContainer& AddedTags);
+
+	UFUNCTION()
+	void OnComponentTagRemoved(UFlowComponent* Component, const FGameplayTagContainer& RemovedTags);
+
+	UFUNCTION()
+	void OnComponentUnregistered(UFlowComponent* Component);
+
+	UFUNCTION()
+	void OnMemberEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+};
@@ -5,6 +5,8 @@
 #include "Engine/DeveloperSettings.h"
 #include "Templates/SubclassOf.h"
 #include "UObject/SoftObjectPath.h"
+
+#include "FlowTypes.h"
 #include "FlowSettings.generated.h"
 
 class UFlowNode;
@@ -27,6 +29,23 @@ class FLOW_API UFlowSettings : public UDeveloperSettings
 	UPROPERTY(Config, EditAnywhere, Category = "SaveSystem")
 	bool bWarnAboutMissingIdentityTags;
 
+	// How often (in seconds) state of Flow Graphs is stored as replay event while recording the network replay
+	// Seeking in the replay restores the latest snapshot instead of re-simulating Flow Graphs from the start
+	// OnSave events aren't called while capturing snapshots, so only SaveGame properties are stored
+	// Set it to 0, if you don't want to record Flow state in replays
+	UPROPERTY(Config, EditAnywhere, Category = "Replays", meta = (ClampMin = 0.0f, Units = "Seconds"))
+	float ReplaySnapshotInterval;
+
+	// How long (in seconds) Flow Subsystem remembers notifies sent by Flow Components
+	// Retroactive On Notify From Actor nodes use it to find recent notifies with a single lookup, instead of inspecting every observed component
+	// Set it to 0, if you don't want to index recent notifies
+	UPROPERTY(Config, EditAnywhere, Category = "Notifies", meta = (ClampMin = 0.0f, Units = "Seconds"))
+	float RecentNotifyRetention;
+
+	// How many notifies can wait for a single World Partition actor to stream in, the oldest notify is discarded on exceeding it
+	UPROPERTY(Config, EditAnywhere, Category = "Notifies", meta = (ClampMin = 1))
+	int32 MaxQueuedNotifiesPerActor;
+
 	// If enabled, runtime logs will be added when a flow node signal mode is set to Disabled
 	UPROPERTY(Config, EditAnywhere, Category = "Flow")
 	bool bLogOnSignalDisabled;
@@ -44,6 +63,46 @@ class FLOW_API UFlowSettings : public UDeveloperSettings
 	UPROPERTY(EditAnywhere, Config, Category = "Nodes", meta = (MustImplement = "/Script/Flow.FlowOwnerInterface"))
 	FSoftClassPath DefaultExpectedOwnerClass;
 
+	// Estimated memory (in kilobytes) a single Flow Asset instance can use before its state gets compacted
+	// Set it to 0, if you don't want to compact instances automatically. Can be overriden per asset
+	UPROPERTY(EditAnywhere, Config, Category = "Memory", meta = (ClampMin = 0, Units = "Kilobytes"))
+	int32 InstanceMemoryBudget;
+
+	// How often Flow Subsystem checks instances against their memory budgets
+	// Set it to 0, if compaction should only happen on explicit UFlowSubsystem::CompactInstances() call
+	UPROPERTY(EditAnywhere, Config, Category = "Memory", meta = (ClampMin = 0.0f, Units = "Seconds"))
+	float CompactionInterval;
+
+	// Content preloaded by nodes is shared across all Flow Asset instances
+	// Content no longer needed by any node stays in memory until this budget (in kilobytes) is exceeded, least recently needed content is released first
+	// Set it to 0, if content should be released as soon as no node needs it
+	UPROPERTY(EditAnywhere, Config, Category = "Memory", meta = (ClampMin = 0, Units = "Kilobytes"))
+	int32 PreloadMemoryBudget;
+
+	// How often Flow Subsystem looks for Root Flows whose owner has been destroyed without finishing them
+	// Actor owners are handled immediately on End Play, this catches any other owners like controllers' subobjects or data objects
+	// Set it to 0, if orphaned Root Flows should only be finished on explicit UFlowSubsystem::ReapOrphanedRootFlows() call
+	UPROPERTY(EditAnywhere, Config, Category = "Memory", meta = (ClampMin = 0.0f, Units = "Seconds"))
+	float OrphanedRootFlowSweepInterval;
+
+	// How Root Flows are finished after their owner has been destroyed
+	UPROPERTY(EditAnywhere, Config, Category = "Memory")
+	EFlowFinishPolicy OrphanedRootFlowFinishPolicy;
+
+	// Number of remembered Identity Tags queries, results are reused until registered components or their tags change
+	// Set it to 0, if every query should scan the component registry
+	UPROPERTY(EditAnywhere, Config, Category = "Memory", meta = (ClampMin = 0))
+	int32 ComponentQueryCacheSize;
+
+	// Limits number of Flow Asset instances owned by objects of given class, including Sub Graphs
+	// Guards the server against spawning bugs or exploits starting unbounded number of graphs
+	UPROPERTY(EditAnywhere, Config, Category = "Quotas", meta = (AllowAbstract = "true"))
+	TMap<TSoftClassPtr<UObject>, FFlowInstanceQuota> OwnerClassQuotas;
+
+	// Root Flows waiting for free quota, beyond this limit new Root Flows are rejected
+	UPROPERTY(EditAnywhere, Config, Category = "Quotas", meta = (ClampMin = 0))
+	int32 MaxQueuedRootFlows;
+
 public:
 	UClass* GetDefaultExpectedOwnerClass() const;
 
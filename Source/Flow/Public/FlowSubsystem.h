@@ -2,14 +2,20 @@
 
 #pragma once
 
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
 #include "GameFramework/Actor.h"
 #include "GameplayTagContainer.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 
 #include "FlowComponent.h"
+#include "FlowComponentProxy.h"
 #include "FlowSubsystem.generated.h"
 
 class UFlowAsset;
+class UFlowAssetVariant;
+class UFlowGroup;
 class UFlowNode_SubGraph;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FSimpleFlowEvent);
@@ -18,6 +24,283 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTaggedFlowComponentEvent, UFlowCom
 
 DECLARE_DELEGATE_OneParam(FNativeFlowAssetEvent, class UFlowAsset*);
 
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowCompactionStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	// How many times subsystem checked instances against their memory budgets
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 Passes;
+
+	// How many times instance exceeded its budget and has been compacted
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 CompactedInstances;
+
+	// Subsystem entries pointing to instances or nodes that no longer exist
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 RemovedStaleEntries;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int64 ReclaimedBytes;
+
+	FFlowCompactionStats()
+		: Passes(0)
+		, CompactedInstances(0)
+		, RemovedStaleEntries(0)
+		, ReclaimedBytes(0)
+	{
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowPreloadStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	// How many times nodes requested to preload content
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 Requests;
+
+	// Requests served by content already preloaded for another node
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 Hits;
+
+	// Content released because Preload Memory Budget was exceeded
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 Evictions;
+
+	// Estimated size of all content currently kept by the subsystem
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int64 CachedBytes;
+
+	FFlowPreloadStats()
+		: Requests(0)
+		, Hits(0)
+		, Evictions(0)
+		, CachedBytes(0)
+	{
+	}
+
+	float GetHitRate() const { return Requests > 0 ? static_cast<float>(Hits) / Requests : 0.0f; }
+};
+
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowOrphanStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	// How many times subsystem looked for Root Flows without a valid owner
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 Sweeps;
+
+	// Root Flows finished by the sweep, owner has been destroyed without finishing them
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 ReapedBySweep;
+
+	// Root Flows finished as their owning actor ended play
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 ReapedOnEndPlay;
+
+	FFlowOrphanStats()
+		: Sweeps(0)
+		, ReapedBySweep(0)
+		, ReapedOnEndPlay(0)
+	{
+	}
+
+	int32 GetTotalReaped() const { return ReapedBySweep + ReapedOnEndPlay; }
+};
+
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowInjectionStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Events injected from any thread and executed on the game thread
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 ExecutedEvents;
+
+	// Events dropped, because the same event has been injected again in the same frame
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 CoalescedEvents;
+
+	// Events dropped, because their target has been destroyed before the queue was drained
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 DiscardedEvents;
+
+	FFlowInjectionStats()
+		: ExecutedEvents(0)
+		, CoalescedEvents(0)
+		, DiscardedEvents(0)
+	{
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowQuotaStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Instances not created, because quota has been exceeded
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 Rejected;
+
+	// Root Flows which had to wait for free quota
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 Queued;
+
+	// Queued Root Flows started after quota has been freed
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 StartedFromQueue;
+
+	// Root Flows aborted to make room for new instances
+	UPROPERTY(BlueprintReadOnly, Category = "Flow")
+	int32 Evicted;
+
+	FFlowQuotaStats()
+		: Rejected(0)
+		, Queued(0)
+		, StartedFromQueue(0)
+		, Evicted(0)
+	{
+	}
+};
+
+enum class EFlowAdmission : uint8
+{
+	Admitted,
+	Rejected,
+	Queued
+};
+
+// Root Flow waiting for free quota
+struct FFlowQueuedRootFlow
+{
+	TWeakObjectPtr<UObject> Owner;
+	TWeakObjectPtr<UFlowAsset> FlowAsset;
+	bool bAllowMultipleInstances;
+	TMap<FName, FString> ParameterValues;
+
+	FFlowQueuedRootFlow(UObject* InOwner, UFlowAsset* InFlowAsset, const bool bInAllowMultipleInstances, const TMap<FName, FString>& InParameterValues)
+		: Owner(InOwner)
+		, FlowAsset(InFlowAsset)
+		, bAllowMultipleInstances(bInAllowMultipleInstances)
+		, ParameterValues(InParameterValues)
+	{
+	}
+};
+
+// Content preloaded once and shared by all nodes that requested it
+struct FFlowPreloadedContent
+{
+	TSharedPtr<FStreamableHandle> Handle;
+	int32 RefCount;
+	double LastRequestTime;
+	SIZE_T EstimatedSize;
+
+	FFlowPreloadedContent()
+		: RefCount(0)
+		, LastRequestTime(0.0)
+		, EstimatedSize(0)
+	{
+	}
+};
+
+// Notify sent by Flow Component, remembered for the retroactive checks
+struct FFlowRecentNotify
+{
+	TWeakObjectPtr<UFlowComponent> Component;
+	double Time;
+
+	FFlowRecentNotify(const TWeakObjectPtr<UFlowComponent> InComponent, const double InTime)
+		: Component(InComponent)
+		, Time(InTime)
+	{
+	}
+};
+
+// Identity Tags query, used as key of remembered query results
+struct FFlowComponentQueryKey
+{
+	FGameplayTagContainer Tags;
+	EGameplayContainerMatchType MatchType;
+	bool bExactMatch;
+
+	FFlowComponentQueryKey(const FGameplayTagContainer& InTags, const EGameplayContainerMatchType InMatchType, const bool bInExactMatch)
+		: Tags(InTags)
+		, MatchType(InMatchType)
+		, bExactMatch(bInExactMatch)
+	{
+	}
+
+	bool operator==(const FFlowComponentQueryKey& Other) const
+	{
+		return MatchType == Other.MatchType && bExactMatch == Other.bExactMatch && Tags == Other.Tags;
+	}
+
+	friend uint32 GetTypeHash(const FFlowComponentQueryKey& Key)
+	{
+		// container equality ignores order of tags, so hash has to ignore it too
+		uint32 TagsHash = 0;
+		for (const FGameplayTag& Tag : Key.Tags)
+		{
+			TagsHash ^= GetTypeHash(Tag);
+		}
+		return HashCombine(TagsHash, HashCombine(GetTypeHash(static_cast<uint8>(Key.MatchType)), GetTypeHash(Key.bExactMatch)));
+	}
+};
+
+enum class EFlowInjectedEventType : uint8
+{
+	NotifyGraph,
+	AddIdentityTag,
+	RemoveIdentityTag,
+	CustomInput
+};
+
+// Event injected from any thread, executed on the game thread when subsystem drains the queue
+struct FFlowInjectedEvent
+{
+	EFlowInjectedEventType Type;
+	TWeakObjectPtr<UObject> Target;
+	FGameplayTag Tag;
+	FName EventName;
+	EFlowNetMode NetMode;
+
+	FFlowInjectedEvent()
+		: Type(EFlowInjectedEventType::NotifyGraph)
+		, NetMode(EFlowNetMode::Authority)
+	{
+	}
+
+	FFlowInjectedEvent(const EFlowInjectedEventType InType, UObject* InTarget, const FGameplayTag& InTag, const FName& InEventName, const EFlowNetMode InNetMode)
+		: Type(InType)
+		, Target(InTarget)
+		, Tag(InTag)
+		, EventName(InEventName)
+		, NetMode(InNetMode)
+	{
+	}
+
+	// Adding and removing the same Identity Tag are the same event for coalescing, the latest one wins
+	bool IsCoalescedWith(const FFlowInjectedEvent& Other) const
+	{
+		return GetCoalescingType() == Other.GetCoalescingType() && Target == Other.Target && Tag == Other.Tag && EventName == Other.EventName;
+	}
+
+	uint32 GetCoalescingHash() const
+	{
+		return HashCombine(HashCombine(GetTypeHash(static_cast<uint8>(GetCoalescingType())), GetTypeHash(Target)), HashCombine(GetTypeHash(Tag), GetTypeHash(EventName)));
+	}
+
+private:
+	EFlowInjectedEventType GetCoalescingType() const
+	{
+		return Type == EFlowInjectedEventType::RemoveIdentityTag ? EFlowInjectedEventType::AddIdentityTag : Type;
+	}
+};
+
 /**
  * Flow Subsystem
  * - manages lifetime of Flow Graphs
@@ -75,7 +358,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
 	virtual void StartRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances = true);
 
-	virtual UFlowAsset* CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances = true);
+	/* Start the root Flow with values of parameters declared in the Flow Asset */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
+	virtual void StartRootFlowWithParameters(UObject* Owner, UFlowAsset* FlowAsset, const TMap<FName, FString>& ParameterValues, const bool bAllowMultipleInstances = true);
+
+	/* Start the root Flow using Flow Asset and parameter values of the variant */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (DefaultToSelf = "Owner"))
+	virtual void StartRootFlowVariant(UObject* Owner, UFlowAssetVariant* Variant, const bool bAllowMultipleInstances = true);
+
+	virtual UFlowAsset* CreateRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances = true, const TMap<FName, FString>& ParameterValues = TMap<FName, FString>());
 
 	/* Finish Policy value is read by Flow Node
 	 * Nodes have opportunity to terminate themselves differently if Flow Graph has been aborted
@@ -93,7 +384,7 @@ protected:
 	UFlowAsset* CreateSubFlow(UFlowNode_SubGraph* SubGraphNode, const FString SavedInstanceName = FString(), const bool bPreloading = false);
 	void RemoveSubFlow(UFlowNode_SubGraph* SubGraphNode, const EFlowFinishPolicy FinishPolicy);
 
-	UFlowAsset* CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, TSoftObjectPtr<UFlowAsset> FlowAsset, FString NewInstanceName = FString());
+	UFlowAsset* CreateFlowInstance(const TWeakObjectPtr<UObject> Owner, TSoftObjectPtr<UFlowAsset> FlowAsset, FString NewInstanceName = FString(), const TMap<FName, FString>& ParameterValues = TMap<FName, FString>());
 
 	virtual void AddInstancedTemplate(UFlowAsset* Template);
 	virtual void RemoveInstancedTemplate(UFlowAsset* Template);
@@ -137,6 +428,221 @@ public:
 	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
 	UFlowSaveGame* GetLoadedSaveGame() const { return LoadedSaveGame; }
 
+//////////////////////////////////////////////////////////////////////////
+// Replays
+
+protected:
+	FTSTicker::FDelegateHandle ReplaySnapshotTickerHandle;
+	FDelegateHandle ReplayScrubHandle;
+
+	/* Demo net driver recording snapshots, a new recording starts numbering snapshot events from zero */
+	TWeakObjectPtr<class UDemoNetDriver> ReplaySnapshotDriver;
+	int32 RecordedReplaySnapshots;
+
+	/* The latest recorded snapshot, unchanged state isn't stored again */
+	TArray<uint8> LastReplaySnapshot;
+
+	/* Set while capturing a snapshot, so OnSave events meant for actual saving aren't called during gameplay */
+	bool bCapturingReplaySnapshot;
+
+public:
+	/* Group of replay events storing snapshots */
+	static const FString ReplaySnapshotGroup;
+
+	/* Stores SaveGame data of all Flow Graphs as replay event, if the world is being recorded */
+	virtual void RecordReplaySnapshot();
+
+	/* Replaces current Flow Graphs with state serialized by RecordReplaySnapshot */
+	virtual void RestoreReplaySnapshot(const TArray<uint8>& Snapshot);
+
+	bool IsCapturingReplaySnapshot() const { return bCapturingReplaySnapshot; }
+
+protected:
+	/* Requests the latest snapshot recorded before the current playback time, and restores it */
+	void RequestReplaySnapshot(UWorld* InWorld);
+
+private:
+	bool TickReplaySnapshot(float DeltaTime);
+	void OnReplayScrubComplete(UWorld* InWorld);
+
+//////////////////////////////////////////////////////////////////////////
+// Memory budgets
+
+protected:
+	FFlowCompactionStats CompactionStats;
+	FTSTicker::FDelegateHandle CompactionTickerHandle;
+
+public:
+	/* Compacts state of instances exceeding their memory budget, removes stale entries from the subsystem
+	 * Called periodically if Compaction Interval is set in Flow Settings */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual void CompactInstances(const bool bIgnoreBudgets = false);
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	const FFlowCompactionStats& GetCompactionStats() const { return CompactionStats; }
+
+private:
+	bool TickCompaction(float DeltaTime);
+
+//////////////////////////////////////////////////////////////////////////
+// Orphaned Root Flows
+
+protected:
+	FFlowOrphanStats OrphanStats;
+	FTSTicker::FDelegateHandle OrphanSweepTickerHandle;
+
+public:
+	/* Finishes Root Flows whose owner no longer exists, returns the number of finished instances
+	 * Called periodically if Orphaned Root Flow Sweep Interval is set in Flow Settings */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual int32 ReapOrphanedRootFlows();
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	const FFlowOrphanStats& GetOrphanStats() const { return OrphanStats; }
+
+protected:
+	/* Actors don't need to wait for the sweep, their Root Flows are finished as soon as they end play */
+	void WatchRootFlowOwner(UObject* Owner);
+
+	UFUNCTION()
+	void OnRootFlowOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+private:
+	bool TickOrphanSweep(float DeltaTime);
+
+//////////////////////////////////////////////////////////////////////////
+// Injected events
+
+protected:
+	/* Multi-producer queue, game systems running on worker threads don't need to marshal every event with AsyncTask */
+	TQueue<FFlowInjectedEvent, EQueueMode::Mpsc> InjectedEvents;
+
+	FFlowInjectionStats InjectionStats;
+	FTSTicker::FDelegateHandle InjectedEventsTickerHandle;
+
+public:
+	/* Thread-safe, calls UFlowComponent::NotifyGraph on the game thread */
+	void InjectNotifyGraph(UFlowComponent* Component, const FGameplayTag& NotifyTag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+
+	/* Thread-safe, calls UFlowComponent::AddIdentityTag on the game thread */
+	void InjectAddIdentityTag(UFlowComponent* Component, const FGameplayTag& Tag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+
+	/* Thread-safe, calls UFlowComponent::RemoveIdentityTag on the game thread */
+	void InjectRemoveIdentityTag(UFlowComponent* Component, const FGameplayTag& Tag, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+
+	/* Thread-safe, calls UFlowAsset::TriggerCustomInput on the game thread */
+	void InjectCustomInput(UFlowAsset* FlowAsset, const FName& EventName);
+
+	/* Executes all injected events, called at the beginning of every frame
+	 * Duplicates injected in the same frame are executed once, at the position of the latest duplicate */
+	virtual void DrainInjectedEvents();
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	const FFlowInjectionStats& GetInjectionStats() const { return InjectionStats; }
+
+protected:
+	virtual void ExecuteInjectedEvent(const FFlowInjectedEvent& Event);
+
+private:
+	bool TickInjectedEvents(float DeltaTime);
+
+//////////////////////////////////////////////////////////////////////////
+// Groups
+
+protected:
+	/* Owners of Root Flows driving many actors at once */
+	UPROPERTY()
+	TArray<UFlowGroup*> Groups;
+
+public:
+	/**
+	 * Starts a single Root Flow owned by the group of actors, instead of starting separate instance for every actor
+	 * 
+	 * @param FlowAsset Graph executed once for the whole group
+	 * @param MemberTags Actors with Flow Component having any of these Identity Tags join the group, and leave it once they lose them or end play
+	 * @param MemberContextClass Optional class of object created for every member, nodes can keep per-member state there
+	 */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem", meta = (AdvancedDisplay = "MemberContextClass"))
+	virtual UFlowGroup* StartGroupFlow(UFlowAsset* FlowAsset, const FGameplayTagContainer MemberTags, const TSubclassOf<UObject> MemberContextClass = nullptr);
+
+	/* Finishes Root Flows owned by the group, members are released */
+	UFUNCTION(BlueprintCallable, Category = "FlowSubsystem")
+	virtual void FinishGroupFlow(UFlowGroup* Group, const EFlowFinishPolicy FinishPolicy);
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	const TArray<UFlowGroup*>& GetGroups() const { return Groups; }
+
+	/* Called by Root Flow owned by the group once it's finished, the group is released with its last Root Flow */
+	virtual void OnGroupFlowFinished(UFlowGroup* Group, UFlowAsset* Instance);
+
+//////////////////////////////////////////////////////////////////////////
+// Quotas
+
+protected:
+	FFlowQuotaStats QuotaStats;
+	TArray<FFlowQueuedRootFlow> QueuedRootFlows;
+	FTSTicker::FDelegateHandle QueuedRootFlowsTickerHandle;
+
+	/* Set while restoring instances from SaveGame, these existed before and can't be dropped */
+	bool bBypassQuotas;
+
+public:
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	const FFlowQuotaStats& GetQuotaStats() const { return QuotaStats; }
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	int32 GetNumQueuedRootFlows() const { return QueuedRootFlows.Num(); }
+
+	/* Called by instance once it's deinitialized, freed quota might admit queued Root Flows */
+	virtual void OnInstanceRemoved(UFlowAsset* Instance);
+
+protected:
+	/* Checks quota of the template and quotas of the owner class, called before creating any instance
+	 * Might evict other Root Flows, if quota uses Evict Oldest policy */
+	virtual EFlowAdmission AdmitInstance(UObject* Owner, UFlowAsset* FlowAsset, const bool bRootFlow);
+
+	EFlowAdmission ApplyQuotaPolicy(const FFlowInstanceQuota& Quota, const bool bRootFlow, TFunctionRef<bool(const UFlowAsset*)> IsWithinQuota, const FString& QuotaDescription);
+	int32 GetNumInstancesOwnedBy(const UClass* OwnerClass) const;
+
+	void QueueRootFlow(UObject* Owner, UFlowAsset* FlowAsset, const bool bAllowMultipleInstances, const TMap<FName, FString>& ParameterValues);
+
+	/* Null Flow Asset matches any Root Flow queued for the owner */
+	bool IsRootFlowQueued(const UObject* Owner, const UFlowAsset* FlowAsset) const;
+
+private:
+	bool RetryQueuedRootFlows(float DeltaTime);
+
+//////////////////////////////////////////////////////////////////////////
+// Preloading content
+
+protected:
+	FStreamableManager StreamableManager;
+
+	/* Content requested by nodes, reference-counted across all Flow Asset instances */
+	TMap<FSoftObjectPath, FFlowPreloadedContent> PreloadedContent;
+
+	FFlowPreloadStats PreloadStats;
+
+public:
+	/* Starts async loading of the asset, or reuses content already preloaded for another node */
+	virtual void AcquirePreloadedContent(const FSoftObjectPath& AssetPath);
+
+	/* Content no longer needed by any node is kept until Preload Memory Budget is exceeded */
+	virtual void ReleasePreloadedContent(const FSoftObjectPath& AssetPath);
+
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	const FFlowPreloadStats& GetPreloadStats() const { return PreloadStats; }
+
+protected:
+	void OnPreloadCompleted(FSoftObjectPath AssetPath);
+
+	/* Sums resource size of loaded assets and everything they reference, as handle keeps all of it loaded */
+	static SIZE_T EstimatePreloadedSize(const FStreamableHandle& Handle);
+
+	void EvictPreloadedContent();
+	void RemovePreloadedContent(const FSoftObjectPath& AssetPath);
+	void FlushPreloadedContent();
+
 //////////////////////////////////////////////////////////////////////////
 // Component Registry
 
@@ -144,6 +650,12 @@ protected:
 	/* All the Flow Components currently existing in the world */
 	TMultiMap<FGameplayTag, TWeakObjectPtr<UFlowComponent>> FlowComponentRegistry;
 
+	/* Results of Identity Tags queries, shared by all Flow Asset instances
+	 * Entry is discarded when component having any of queried tags is registered, unregistered or its tags change */
+	mutable TMap<FFlowComponentQueryKey, TSet<TWeakObjectPtr<UFlowComponent>>> ComponentQueryCache;
+
+	void InvalidateComponentQueries(const FGameplayTagContainer& ChangedTags);
+
 protected:
 	virtual void RegisterComponent(UFlowComponent* Component);
 	virtual void OnIdentityTagAdded(UFlowComponent* Component, const FGameplayTag& AddedTag);
@@ -426,7 +938,94 @@ public:
 		return Result;
 	}
 
+//////////////////////////////////////////////////////////////////////////
+// Registry proxies
+
+protected:
+	/* Flow Components of actors in World Partition cells, available even if cell isn't loaded */
+	TArray<FFlowComponentProxy> ComponentProxies;
+
+	TMultiMap<FGameplayTag, int32> ProxyRegistry;
+
+	/* Proxies are matched by Proxy Guid of the Flow Component, as Actor Guid is editor-only and soft path of the actor differs at runtime (streaming cell packages, PIE prefix) */
+	TMap<FGuid, int32> ProxyIndexByActorGuid;
+
+	/* Indices of proxies whose actor has registered its Flow Component */
+	TSet<int32> LoadedProxies;
+
+	/* Notifies sent to actors that weren't loaded yet, key is index of the proxy, ordered by time of sending */
+	TMap<int32, TArray<FFlowQueuedNotify>> QueuedNotifies;
+
+public:
+	/* Called by Flow World Settings, provides proxies generated in the editor */
+	virtual void RegisterComponentProxies(const TArray<FFlowComponentProxy>& Proxies);
+	virtual void UnregisterComponentProxies();
+
+	/**
+	 * Returns proxies of Flow Components in World Partition cells, identified by given tag
+	 * 
+	 * @param Tag Tag to check if it matches Identity Tags of proxies
+	 * @param bOnlyUnloaded If true, only proxies of actors that currently aren't loaded will be returned
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then Identity Tags of proxy will include it's parent tags while matching. Latter option scans all proxies
+	 */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	TArray<FFlowComponentProxy> GetComponentProxiesByTag(const FGameplayTag Tag, const bool bOnlyUnloaded = true, const bool bExactMatch = true) const;
+
+	/**
+	 * Returns proxies of Flow Components in World Partition cells, identified by Any or All provided tags
+	 * 
+	 * @param Tags Container to check if it matches Identity Tags of proxies
+	 * @param MatchType If Any, returned proxy needs to have only one of given tags. If All, proxy needs to have all given Identity Tags
+	 * @param bOnlyUnloaded If true, only proxies of actors that currently aren't loaded will be returned
+	 * @param bExactMatch If true, the tag has to be exactly present, if false then Identity Tags of proxy will include it's parent tags while matching. Latter option scans all proxies
+	 */
+	UFUNCTION(BlueprintPure, Category = "FlowSubsystem")
+	TArray<FFlowComponentProxy> GetComponentProxiesByTags(const FGameplayTagContainer Tags, const EGameplayContainerMatchType MatchType, const bool bOnlyUnloaded = true, const bool bExactMatch = true) const;
+
+	/* Queues notifies for every unloaded actor matching given Identity Tags, delivered when actor streams in
+	 * Tags are matched the same way as in GetComponents, so loaded and unloaded actors receive the same notifies
+	 * Returns number of actors that will receive notifies */
+	virtual int32 QueueNotifyForUnloadedActors(const FGameplayTagContainer& IdentityTags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, const FGameplayTagContainer& NotifyTags, UFlowComponent* Sender, const bool bFromGraph, const EFlowNetMode NetMode = EFlowNetMode::Authority);
+
+	bool IsProxyLoaded(const int32 ProxyIndex) const { return LoadedProxies.Contains(ProxyIndex); }
+
+protected:
+	int32 FindProxyIndex(const UFlowComponent* Component) const;
+	void FindProxies(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, const bool bOnlyUnloaded, TArray<int32>& OutProxyIndices) const;
+	void DeliverQueuedNotifies(UFlowComponent* Component);
+
+//////////////////////////////////////////////////////////////////////////
+// Recent notifies
+
+protected:
+	/* Notifies sent within Recent Notify Retention time, ordered by time of sending */
+	TMap<FGameplayTag, TArray<FFlowRecentNotify>> RecentNotifies;
+
+	virtual void RecordRecentNotifies(UFlowComponent* Component, const FGameplayTagContainer& NotifyTags);
+	void PruneRecentNotifies();
+
+	double GetRecentNotifyTime() const;
+
+public:
+	bool IsIndexingRecentNotifies() const;
+
+	/**
+	 * Returns registered Flow Components that recently sent any of given notifies
+	 * 
+	 * @param NotifyTags Notifies sent within Recent Notify Retention time set in Flow Settings
+	 * @param IdentityTags Tags to check if it matches Identity Tags of components that sent notify
+	 * @param MatchType How Identity Tags are compared
+	 */
+	void FindRecentNotifySenders(const FGameplayTagContainer& NotifyTags, const FGameplayTagContainer& IdentityTags, const EFlowTagContainerMatchType MatchType, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
+
 private:
 	void FindComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
 	void FindComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
+
+	// Scans the registry, ignoring remembered results
+	void CollectComponents(const FGameplayTag& Tag, const bool bExactMatch, TArray<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
+	void CollectComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch, TSet<TWeakObjectPtr<UFlowComponent>>& OutComponents) const;
+
+	// Returns remembered query result, runs the query if needed
+	const TSet<TWeakObjectPtr<UFlowComponent>>& FindCachedComponents(const FGameplayTagContainer& Tags, const EGameplayContainerMatchType MatchType, const bool bExactMatch) const;
 };
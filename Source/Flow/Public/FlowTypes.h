@@ -46,6 +46,15 @@ enum class EFlowSignalMode : uint8
 	PassThrough UMETA(ToolTip = "Internal node logic not executed. All connected outputs are triggered, node finishes its work.")
 };
 
+UENUM(BlueprintType)
+enum class EFlowCookTarget : uint8
+{
+	All				UMETA(ToolTip = "Node is cooked for every target."),
+	ServerOnly		UMETA(ToolTip = "Stripped from client-only cooks, i.e. authority gameplay logic."),
+	ClientOnly		UMETA(ToolTip = "Stripped from dedicated server cooks, i.e. purely cosmetic nodes."),
+	EditorOnly		UMETA(ToolTip = "Stripped from every cook, i.e. debugging nodes.")
+};
+
 UENUM(BlueprintType)
 enum class EFlowNetMode : uint8
 {
@@ -91,3 +100,71 @@ enum class EFlowOnScreenMessageType : uint8
 	Temporary,
 	Permanent
 };
+
+// What happens if starting another instance would exceed the quota
+UENUM(BlueprintType)
+enum class EFlowQuotaPolicy : uint8
+{
+	Reject			UMETA(ToolTip = "New instance isn't created."),
+	Queue			UMETA(ToolTip = "Root Flow starts once another instance finishes. Sub Graphs can't wait, so they're rejected."),
+	EvictOldest		UMETA(ToolTip = "The oldest Root Flow within the quota is aborted to make room for the new one.")
+};
+
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowInstanceQuota
+{
+	GENERATED_USTRUCT_BODY()
+
+	// Maximum number of instances running at the same time, 0 means unlimited
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Quota", meta = (ClampMin = 0))
+	int32 MaxInstances;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Quota")
+	EFlowQuotaPolicy Policy;
+
+	FFlowInstanceQuota()
+		: MaxInstances(0)
+		, Policy(EFlowQuotaPolicy::Reject)
+	{
+	}
+
+	bool IsLimited() const { return MaxInstances > 0; }
+};
+
+// Node property driven by the Flow Asset parameter
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowParameterBinding
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Parameters")
+	FGuid NodeGuid;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Parameters")
+	FName PropertyName;
+
+	FFlowParameterBinding()
+	{
+	}
+};
+
+// Value supplied per instance or per Flow Asset Variant, imported as text into every bound node property
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowAssetParameter
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Parameters")
+	FName Name;
+
+	// Used if instance doesn't provide value, empty keeps values set on nodes
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Parameters")
+	FString DefaultValue;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Parameters")
+	TArray<FFlowParameterBinding> Bindings;
+
+	FFlowAssetParameter()
+	{
+	}
+};
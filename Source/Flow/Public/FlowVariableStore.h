@@ -0,0 +1,137 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "FlowVariableStore.generated.h"
+
+UENUM(BlueprintType)
+enum class EFlowVariableType : uint8
+{
+	Bool,
+	Int,
+	Float,
+	Name,
+	String,
+	GameplayTag,
+
+	MAX UMETA(Hidden)
+};
+
+// Variable declared on the Flow Asset, every instance gets its own copy
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowVariableDesc
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Variables")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Variables")
+	EFlowVariableType Type;
+
+	// Imported as text, i.e. "true", "42", "1.5" or "Quest.Stage.Finished"
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Variables")
+	FString DefaultValue;
+
+	FFlowVariableDesc()
+		: Type(EFlowVariableType::Bool)
+	{
+	}
+};
+
+// Node property pointing at the variable
+// Name is resolved to the typed slot when asset is saved or cooked, so reading the variable doesn't require any lookup
+USTRUCT(BlueprintType)
+struct FLOW_API FFlowVariableReference
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Variables")
+	FName Name;
+
+	UPROPERTY()
+	EFlowVariableType Type;
+
+	// Index in the array of variables of the same type
+	UPROPERTY()
+	int32 Index;
+
+	FFlowVariableReference()
+		: Type(EFlowVariableType::Bool)
+		, Index(INDEX_NONE)
+	{
+	}
+
+	bool IsResolved() const { return Index != INDEX_NONE; }
+};
+
+// Runtime values of all variables of the Flow Asset instance, grouped by type
+// Serialized as a single block, without property tags, preceded by hash of names and types of declared variables
+USTRUCT()
+struct FLOW_API FFlowVariableStore
+{
+	GENERATED_USTRUCT_BODY()
+
+private:
+	uint32 LayoutHash;
+
+	TArray<bool> Bools;
+	TArray<int32> Ints;
+	TArray<float> Floats;
+	TArray<FName> Names;
+	TArray<FString> Strings;
+	TArray<FGameplayTag> GameplayTags;
+
+public:
+	FFlowVariableStore()
+		: LayoutHash(0)
+	{
+	}
+
+	// Creates slots for declared variables and sets their default values
+	void Initialize(const TArray<FFlowVariableDesc>& Variables);
+
+	// False if variables declared on the asset changed since the store was saved, including renamed or reordered variables
+	bool MatchesLayout(const TArray<FFlowVariableDesc>& Variables) const;
+
+	// Stable across sessions, as it's saved with the store
+	static uint32 CalcLayoutHash(const TArray<FFlowVariableDesc>& Variables);
+
+	// Assigns slot indices to references, in order of declaration
+	static void ResolveReference(const TArray<FFlowVariableDesc>& Variables, FFlowVariableReference& Reference);
+
+	bool GetBool(const FFlowVariableReference& Variable) const;
+	int32 GetInt(const FFlowVariableReference& Variable) const;
+	float GetFloat(const FFlowVariableReference& Variable) const;
+	FName GetName(const FFlowVariableReference& Variable) const;
+	const FString& GetString(const FFlowVariableReference& Variable) const;
+	FGameplayTag GetGameplayTag(const FFlowVariableReference& Variable) const;
+
+	void SetBool(const FFlowVariableReference& Variable, const bool bValue);
+	void SetInt(const FFlowVariableReference& Variable, const int32 Value);
+	void SetFloat(const FFlowVariableReference& Variable, const float Value);
+	void SetName(const FFlowVariableReference& Variable, const FName& Value);
+	void SetString(const FFlowVariableReference& Variable, const FString& Value);
+	void SetGameplayTag(const FFlowVariableReference& Variable, const FGameplayTag& Value);
+
+	SIZE_T GetAllocatedSize() const;
+
+	bool Serialize(FArchive& Ar);
+
+private:
+	template <typename T>
+	static bool IsValidSlot(const TArray<T>& Slots, const FFlowVariableReference& Variable, const EFlowVariableType ExpectedType)
+	{
+		return ensureMsgf(Variable.Type == ExpectedType && Slots.IsValidIndex(Variable.Index), TEXT("Flow variable %s isn't resolved or has different type"), *Variable.Name.ToString());
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FFlowVariableStore> : public TStructOpsTypeTraitsBase2<FFlowVariableStore>
+{
+	enum
+	{
+		WithSerializer = true
+	};
+};
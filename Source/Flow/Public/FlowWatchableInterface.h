@@ -0,0 +1,26 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "UObject/Interface.h"
+
+#include "FlowWatchableInterface.generated.h"
+
+// Source object and name of the changed value, None means that any value might have changed
+DECLARE_MULTICAST_DELEGATE_TwoParams(FFlowWatchedValueChanged, UObject* /*Source*/, const FName& /*ValueName*/);
+
+// (optional) interface to let Watch Value nodes subscribe to value changes, instead of polling them
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UFlowWatchableInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class FLOW_API IFlowWatchableInterface
+{
+	GENERATED_BODY()
+
+public:
+	// Implementation should broadcast this delegate after changing a value that might be watched
+	virtual FFlowWatchedValueChanged& GetOnWatchedValueChanged() = 0;
+};
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "GameFramework/WorldSettings.h"
+
+#include "FlowComponentProxy.h"
 #include "FlowWorldSettings.generated.h"
 
 class UFlowComponent;
@@ -21,4 +23,12 @@ private:
 
 public:
 	UFlowComponent* GetFlowComponent() const { return FlowComponent; }
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Flow Components of actors placed in World Partition cells, registered in the Flow Subsystem as proxies while cells are unloaded
+	// Generated by FlowRegistryProxy commandlet
+	UPROPERTY(VisibleAnywhere, Category = "Flow")
+	TArray<FFlowComponentProxy> ComponentProxies;
 };
@@ -34,6 +34,8 @@ class FLOW_API UFlowNode : public UObject, public IVisualLoggerDebugSnapshotInte
 	friend class UFlowGraphSchema;
 	friend class SFlowInputPinHandle;
 	friend class SFlowOutputPinHandle;
+	friend class FFlowTestHarness;
+	friend class UFlowNodeReplaceCommandlet;
 
 //////////////////////////////////////////////////////////////////////////
 // Node
@@ -76,6 +78,15 @@ public:
 #endif
 
 public:
+	// UObject
+	virtual bool IsEditorOnly() const override;
+#if WITH_EDITOR
+	virtual bool NeedsLoadForTargetPlatform(const ITargetPlatform* TargetPlatform) const override;
+#endif
+	// --
+
+	EFlowCookTarget GetCookTarget() const { return CookTarget; }
+
 #if WITH_EDITOR
 	// UObject	
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -136,6 +147,13 @@ public:
 	//  NOTE - will consider a UActorComponent owner's owning actor if appropriate
 	IFlowOwnerInterface* GetFlowOwnerInterface() const;
 
+	// Returns the group owning this Node's RootFlow, if it has been started by UFlowSubsystem::StartGroupFlow
+	UFUNCTION(BlueprintPure, Category = "FlowNode")
+	class UFlowGroup* GetFlowGroup() const;
+
+	// Variables of the Flow Asset instance, read and written via FFlowVariableReference properties of this node
+	struct FFlowVariableStore* GetVariableStore() const;
+
 protected:
 
 	// Helper functions for GetFlowOwnerInterface()
@@ -148,6 +166,12 @@ protected:
 public:	
 	virtual bool CanFinishGraph() const { return false; }
 
+#if WITH_EDITOR
+	// Opt-in for copying this node into the parent graph, if Sub Graph is marked as Inline On Cook
+	// Only nodes that keep no state and don't wait for anything after executing input should return true
+	virtual bool CanBeInlined() const { return false; }
+#endif
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "FlowNode")
 	TArray<EFlowSignalMode> AllowedSignalModes;
@@ -157,6 +181,10 @@ protected:
 	UPROPERTY()
 	EFlowSignalMode SignalMode;
 
+	// Targets this node is cooked for. Stripped node acts as pass-through, its referenced assets aren't loaded on that target
+	UPROPERTY(EditAnywhere, Category = "FlowNode", AdvancedDisplay)
+	EFlowCookTarget CookTarget;
+
 #if WITH_EDITOR
 	FFlowMessageLog ValidationLog;
 #endif
@@ -203,6 +231,10 @@ public:
 	// Be careful, enabling it might cause loading gigabytes of data as nodes would load all related data (i.e. Level Sequences)
 	virtual bool CanRefreshContextPinsOnLoad() const { return false; }
 
+	// Assets providing context pins, editor skips refreshing context pins on graph open if none of these assets changed
+	// Return false if context pins depend on anything else, these are refreshed every time
+	virtual bool GetContextPinsDependencies(TArray<FSoftObjectPath>& OutAssets) const { return false; }
+
 	virtual TArray<FFlowPin> GetContextInputs() { return TArray<FFlowPin>(); }
 	virtual TArray<FFlowPin> GetContextOutputs() { return TArray<FFlowPin>(); }
 
@@ -294,9 +326,17 @@ public:
 	void TriggerFlush();
 
 protected:
+	// Assets preloaded through the Flow Subsystem, released automatically when node is flushed
+	TArray<FSoftObjectPath> PreloadedAssets;
+
 	virtual void PreloadContent();
 	virtual void FlushContent();
 
+	// Requests async loading of the asset, content is shared with other nodes requesting the same asset
+	// Call it from Preload Content
+	UFUNCTION(BlueprintCallable, Category = "FlowNode")
+	void PreloadAsset(const FSoftObjectPath& AssetPath);
+
 	UFUNCTION(BlueprintImplementableEvent, Category = "FlowNode", meta = (DisplayName = "Preload Content"))
 	void K2_PreloadContent();
 
@@ -366,6 +406,12 @@ protected:
 private:
 	void ResetRecords();
 
+	// Returns memory allocated by pin records, used only for debugging
+	SIZE_T GetRecordsAllocatedSize() const;
+
+	// Keeps only the latest record of every pin, returns number of released bytes
+	SIZE_T CompactRecords();
+
 //////////////////////////////////////////////////////////////////////////
 // SaveGame support
 
@@ -182,6 +182,16 @@ struct FLOW_API FConnectedPin
 	}
 };
 
+// Connected outputs of the node stripped from the cooked build, triggered instead of executing the node
+USTRUCT()
+struct FLOW_API FFlowPassThroughConnections
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	TArray<FConnectedPin> Connections;
+};
+
 UENUM(BlueprintType)
 enum class EFlowPinActivationType : uint8
 {
@@ -21,5 +21,6 @@ protected:
 #if WITH_EDITOR
 public:
 	virtual FText GetNodeTitle() const override;
+	virtual bool CanBeInlined() const override { return true; }
 #endif
 };
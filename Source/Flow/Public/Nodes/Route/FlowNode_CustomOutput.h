@@ -19,5 +19,8 @@ protected:
 
 #if WITH_EDITOR
 	virtual FText GetNodeTitle() const override;
+
+public:
+	virtual bool CanBeInlined() const override { return true; }
 #endif
 };
@@ -17,4 +17,9 @@ class FLOW_API UFlowNode_Start : public UFlowNode
 
 protected:
 	virtual void ExecuteInput(const FName& PinName) override;
+
+#if WITH_EDITOR
+public:
+	virtual bool CanBeInlined() const override { return true; }
+#endif
 };
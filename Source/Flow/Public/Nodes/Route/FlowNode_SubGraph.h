@@ -24,6 +24,10 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Graph")
 	TSoftObjectPtr<UFlowAsset> Asset;
 
+	// Values of parameters declared in the Sub Graph asset, parameters not listed here use their default values
+	UPROPERTY(EditAnywhere, Category = "Graph")
+	TMap<FName, FString> ParameterValues;
+
 	/*
 	 * Allow to create instance of the same Flow Asset as the asset containing this node
 	 * Enabling it may cause an infinite loop, if graph would keep creating copies of itself
@@ -68,6 +72,7 @@ public:
 	virtual EDataValidationResult ValidateNode() override;
 	
 	virtual bool SupportsContextPins() const override { return true; }
+	virtual bool GetContextPinsDependencies(TArray<FSoftObjectPath>& OutAssets) const override;
 
 	virtual TArray<FFlowPin> GetContextInputs() override;
 	virtual TArray<FFlowPin> GetContextOutputs() override;
@@ -48,5 +48,6 @@ protected:
 #if WITH_EDITOR
 public:
 	virtual FString GetNodeDescription() const override;
+	virtual bool CanBeInlined() const override { return true; }
 #endif
 };
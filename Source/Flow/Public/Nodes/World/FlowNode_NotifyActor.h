@@ -41,5 +41,6 @@ protected:
 public:
 	virtual FString GetNodeDescription() const override;
 	virtual EDataValidationResult ValidateNode() override;
+	virtual bool CanBeInlined() const override { return true; }
 #endif
 };
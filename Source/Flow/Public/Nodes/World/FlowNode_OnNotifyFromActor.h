@@ -22,6 +22,8 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Notify")
 	bool bRetroactive;
 
+	virtual void StartObserving() override;
+
 	virtual void ObserveActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component) override;
 	virtual void ForgetActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component) override;
 
@@ -3,7 +3,6 @@
 #pragma once
 
 #include "EngineDefines.h"
-#include "Engine/StreamableManager.h"
 #include "LevelSequencePlayer.h"
 #include "MovieSceneSequencePlayer.h"
 
@@ -81,11 +80,10 @@ protected:
 	UPROPERTY(SaveGame)
 	float TimeDilation;
 
-	FStreamableManager StreamableManager;
-
 public:
 #if WITH_EDITOR
 	virtual bool SupportsContextPins() const override { return true; }
+	virtual bool GetContextPinsDependencies(TArray<FSoftObjectPath>& OutAssets) const override;
 	virtual TArray<FFlowPin> GetContextOutputs() override;
 
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -0,0 +1,63 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Nodes/World/FlowNode_ComponentObserver.h"
+#include "FlowNode_WatchValue.generated.h"
+
+/**
+ * Triggers output when watched property changes its value, replacing Timer-based polling of the gameplay state
+ * Watched object has to implement Flow Watchable Interface and broadcast value changes, i.e. by calling NotifyValueChanged on the Flow Component
+ * Property is resolved on the watched object first, then on its owning actor
+ */
+UCLASS(NotBlueprintable, meta = (DisplayName = "Watch Value", Keywords = "property, poll, wait"))
+class FLOW_API UFlowNode_WatchValue : public UFlowNode_ComponentObserver
+{
+	GENERATED_UCLASS_BODY()
+
+protected:
+	// If true, node watches the owner of the Root Flow instead of components matching Identity Tags
+	UPROPERTY(EditAnywhere, Category = "Watch")
+	bool bWatchFlowOwner;
+
+	UPROPERTY(EditAnywhere, Category = "Watch")
+	FName PropertyName;
+
+	// If set, output is triggered only on transition to this value, i.e. "True", "5" or enum entry name
+	// If empty, every change of the value triggers output
+	UPROPERTY(EditAnywhere, Category = "Watch")
+	FString TargetValue;
+
+	// If true, output is triggered immediately if the value already equals Target Value when node starts watching
+	UPROPERTY(EditAnywhere, Category = "Watch")
+	bool bTriggerIfAlreadyMatching;
+
+	// Last known value of every watched object
+	TMap<TWeakObjectPtr<UObject>, FString> WatchedValues;
+
+	virtual void ExecuteInput(const FName& PinName) override;
+	virtual void OnLoad_Implementation() override;
+
+	virtual void StartObserving() override;
+	virtual void StopObserving() override;
+
+	virtual void ObserveActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component) override;
+	virtual void ForgetActor(TWeakObjectPtr<AActor> Actor, TWeakObjectPtr<UFlowComponent> Component) override;
+
+	void WatchObject(UObject* Object);
+	void ForgetObject(UObject* Object);
+
+	virtual void OnWatchedValueChanged(UObject* Source, const FName& ValueName);
+
+	bool ReadValue(const UObject* Source, FString& OutValue) const;
+
+	virtual void Cleanup() override;
+
+#if WITH_EDITOR
+public:
+	virtual FString GetNodeDescription() const override;
+	virtual EDataValidationResult ValidateNode() override;
+
+	virtual FString GetStatusString() const override;
+#endif
+};
@@ -26,6 +26,7 @@ public class FlowEditor : ModuleRules
 			"Core",
 			"CoreUObject",
 			"DetailCustomizations",
+			"DerivedDataCache",
 			"DeveloperSettings",
 			"EditorFramework",
 			"EditorScriptingUtilities",
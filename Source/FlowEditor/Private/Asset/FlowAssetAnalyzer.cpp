@@ -0,0 +1,254 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Asset/FlowAssetAnalyzer.h"
+#include "Graph/FlowGraphSettings.h"
+
+#include "FlowAsset.h"
+#include "FlowMessageLog.h"
+#include "FlowSave.h"
+#include "Nodes/FlowNode.h"
+#include "Nodes/Route/FlowNode_SubGraph.h"
+#include "Nodes/World/FlowNode_ComponentObserver.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "DerivedDataCacheInterface.h"
+#include "Misc/SecureHash.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Change it whenever the analysis or FFlowAssetComplexity changes, to invalidate cached results
+#define FLOW_COMPLEXITY_DERIVEDDATA_VER TEXT("8E2F4C1A9B3D4E6F8A1B2C3D4E5F6A7B")
+
+FString FFlowAssetComplexity::ToString() const
+{
+	return FString::Printf(TEXT("Nodes: %d, Synchronous Chain Depth: %d, Observers: %d, Sub Graph Depth: %d, Instance Memory: %.1f KB, Save Size: %.1f KB"),
+		NodeCount, MaxSynchronousChainDepth, ObserverNodeCount, SubGraphDepth, EstimatedInstanceMemory / 1024.0f, EstimatedSaveSize / 1024.0f);
+}
+
+FFlowAssetComplexity FFlowAssetAnalyzer::Analyze(UFlowAsset* FlowAsset)
+{
+	FFlowAssetComplexity Complexity;
+
+	if (FlowAsset)
+	{
+		TSet<const UFlowAsset*> VisitedAssets;
+		AnalyzeAsset(FlowAsset, 0, VisitedAssets, Complexity);
+	}
+
+	return Complexity;
+}
+
+FFlowAssetComplexity FFlowAssetAnalyzer::AnalyzeCached(const FAssetData& AssetData)
+{
+	FFlowAssetComplexity Complexity;
+
+	FString CacheKey;
+	if (!GetCacheKey(AssetData, CacheKey))
+	{
+		return Analyze(Cast<UFlowAsset>(AssetData.GetAsset()));
+	}
+
+	TArray<uint8> CachedData;
+	if (GetDerivedDataCacheRef().GetSynchronous(*CacheKey, CachedData, AssetData.GetObjectPathString()))
+	{
+		FMemoryReader Reader(CachedData);
+		Reader << Complexity;
+		return Complexity;
+	}
+
+	Complexity = Analyze(Cast<UFlowAsset>(AssetData.GetAsset()));
+
+	FMemoryWriter Writer(CachedData);
+	Writer << Complexity;
+	GetDerivedDataCacheRef().Put(*CacheKey, CachedData, AssetData.GetObjectPathString());
+
+	return Complexity;
+}
+
+bool FFlowAssetAnalyzer::GetCacheKey(const FAssetData& AssetData, FString& OutCacheKey)
+{
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+
+	// result depends on nested Sub Graphs and node blueprints, so every package reachable from the asset is part of the key
+	TArray<FName> Packages = {AssetData.PackageName};
+	TSet<FName> VisitedPackages = {AssetData.PackageName};
+	for (int32 Index = 0; Index < Packages.Num(); Index++)
+	{
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(Packages[Index], Dependencies, UE::AssetRegistry::EDependencyCategory::Package);
+		for (const FName& Dependency : Dependencies)
+		{
+			// script packages don't have saved hash, code changes require bumping the cache version
+			if (!VisitedPackages.Contains(Dependency) && !FPackageName::IsScriptPackage(Dependency.ToString()))
+			{
+				VisitedPackages.Add(Dependency);
+				Packages.Add(Dependency);
+			}
+		}
+	}
+
+	// sorted, so the key doesn't depend on the order of registry results
+	Packages.Sort(FNameLexicalLess());
+
+	FString Suffix;
+	for (const FName& PackageName : Packages)
+	{
+		// unsaved changes aren't reflected by the package hash
+		if (const UPackage* LoadedPackage = FindPackage(nullptr, *PackageName.ToString()))
+		{
+			if (LoadedPackage->IsDirty())
+			{
+				return false;
+			}
+		}
+
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		if (!PackageData.IsSet())
+		{
+			return false;
+		}
+
+		Suffix += LexToString(PackageData->GetPackageSavedHash());
+	}
+
+	OutCacheKey = FDerivedDataCacheInterface::BuildCacheKey(TEXT("FLOWCOMPLEXITY"), FLOW_COMPLEXITY_DERIVEDDATA_VER, *FString::Printf(TEXT("%s_%s"), *AssetData.PackageName.ToString(), *FMD5::HashAnsiString(*Suffix)));
+	return true;
+}
+
+bool FFlowAssetAnalyzer::CheckBudgets(UFlowAsset* FlowAsset, const FFlowAssetComplexity& Complexity, FFlowMessageLog& MessageLog)
+{
+	const UFlowGraphSettings* Settings = UFlowGraphSettings::Get();
+	bool bWithinBudgets = true;
+
+	const auto CheckBudget = [&](const int64 Value, const int64 Budget, const TCHAR* MetricName)
+	{
+		if (Budget > 0 && Value > Budget)
+		{
+			MessageLog.Warning<UFlowAsset>(*FString::Printf(TEXT("%s exceeds budget: %lld > %lld"), MetricName, Value, Budget), FlowAsset);
+			bWithinBudgets = false;
+		}
+	};
+
+	CheckBudget(Complexity.NodeCount, Settings->MaxNodeCount, TEXT("Node count"));
+	CheckBudget(Complexity.MaxSynchronousChainDepth, Settings->MaxSynchronousChainDepth, TEXT("Synchronous chain depth"));
+	CheckBudget(Complexity.ObserverNodeCount, Settings->MaxObserverNodeCount, TEXT("Observer node count"));
+	CheckBudget(Complexity.SubGraphDepth, Settings->MaxSubGraphDepth, TEXT("Sub Graph depth"));
+	CheckBudget(Complexity.EstimatedInstanceMemory, static_cast<int64>(Settings->MaxInstanceMemory) * 1024, TEXT("Estimated instance memory (bytes)"));
+	CheckBudget(Complexity.EstimatedSaveSize, static_cast<int64>(Settings->MaxSaveSize) * 1024, TEXT("Estimated save size (bytes)"));
+
+	return bWithinBudgets;
+}
+
+void FFlowAssetAnalyzer::AnalyzeAsset(UFlowAsset* FlowAsset, const int32 SubGraphDepth, TSet<const UFlowAsset*>& VisitedAssets, FFlowAssetComplexity& OutComplexity)
+{
+	// recursive Sub Graphs aren't allowed, but we can't assume every asset has been validated
+	if (VisitedAssets.Contains(FlowAsset))
+	{
+		return;
+	}
+	VisitedAssets.Add(FlowAsset);
+
+	OutComplexity.SubGraphDepth = FMath::Max(OutComplexity.SubGraphDepth, SubGraphDepth);
+	OutComplexity.EstimatedInstanceMemory += FlowAsset->GetClass()->GetStructureSize();
+
+	TMap<const UFlowNode*, int32> CachedDepths;
+	for (const TPair<FGuid, UFlowNode*>& Node : FlowAsset->GetNodes())
+	{
+		UFlowNode* FlowNode = Node.Value;
+		if (FlowNode == nullptr)
+		{
+			continue;
+		}
+
+		// metrics of the root asset only, nested graphs are executed in separate chains
+		if (SubGraphDepth == 0)
+		{
+			OutComplexity.NodeCount++;
+
+			TMap<const UFlowNode*, int32> NodesInChain;
+			int32 LowestLoopStart = MAX_int32;
+			OutComplexity.MaxSynchronousChainDepth = FMath::Max(OutComplexity.MaxSynchronousChainDepth, GetSynchronousChainDepth(FlowNode, CachedDepths, NodesInChain, LowestLoopStart));
+		}
+
+		if (FlowNode->IsA<UFlowNode_ComponentObserver>())
+		{
+			OutComplexity.ObserverNodeCount++;
+		}
+
+		OutComplexity.EstimatedInstanceMemory += FlowNode->GetClass()->GetStructureSize();
+
+		// SaveGame properties serialized the same way as UFlowNode::SaveInstance does it
+		{
+			TArray<uint8> NodeData;
+			FMemoryWriter MemoryWriter(NodeData, true);
+			FFlowArchive Ar(MemoryWriter);
+			FlowNode->Serialize(Ar);
+
+			OutComplexity.EstimatedSaveSize += NodeData.Num() + sizeof(FGuid);
+		}
+
+		if (const UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(FlowNode))
+		{
+			if (UFlowAsset* SubGraphAsset = SubGraphNode->Asset.LoadSynchronous())
+			{
+				AnalyzeAsset(SubGraphAsset, SubGraphDepth + 1, VisitedAssets, OutComplexity);
+			}
+		}
+	}
+
+	// the same Sub Graph asset can be used by many nodes, every node creates its own instance
+	VisitedAssets.Remove(FlowAsset);
+}
+
+int32 FFlowAssetAnalyzer::GetSynchronousChainDepth(UFlowNode* Node, TMap<const UFlowNode*, int32>& CachedDepths, TMap<const UFlowNode*, int32>& NodesInChain, int32& OutLowestLoopStart)
+{
+	if (const int32* CachedDepth = CachedDepths.Find(Node))
+	{
+		return *CachedDepth;
+	}
+
+	// node will continue execution later, it ends the synchronous chain
+	if (IsLatentNode(Node))
+	{
+		CachedDepths.Add(Node, 1);
+		return 1;
+	}
+
+	// loop in the graph, count every node only once
+	if (const int32* LoopStart = NodesInChain.Find(Node))
+	{
+		OutLowestLoopStart = FMath::Min(OutLowestLoopStart, *LoopStart);
+		return 0;
+	}
+
+	const int32 PositionInChain = NodesInChain.Num();
+	NodesInChain.Add(Node, PositionInChain);
+
+	int32 MaxConnectedDepth = 0;
+	int32 LowestLoopStart = MAX_int32;
+	for (UFlowNode* ConnectedNode : Node->GetConnectedNodes())
+	{
+		if (ConnectedNode)
+		{
+			MaxConnectedDepth = FMath::Max(MaxConnectedDepth, GetSynchronousChainDepth(ConnectedNode, CachedDepths, NodesInChain, LowestLoopStart));
+		}
+	}
+
+	NodesInChain.Remove(Node);
+	OutLowestLoopStart = FMath::Min(OutLowestLoopStart, LowestLoopStart);
+
+	// depth computed with a loop cut at the node visited before this one depends on the path we came from, it's not valid for other paths
+	const int32 Depth = MaxConnectedDepth + 1;
+	if (LowestLoopStart >= PositionInChain)
+	{
+		CachedDepths.Add(Node, Depth);
+	}
+	return Depth;
+}
+
+bool FFlowAssetAnalyzer::IsLatentNode(const UFlowNode* Node)
+{
+	const EFlowNodeStyle NodeStyle = Node->GetNodeStyle();
+	return NodeStyle == EFlowNodeStyle::Latent || NodeStyle == EFlowNodeStyle::SubGraph || Node->IsA<UFlowNode_ComponentObserver>();
+}
@@ -6,9 +6,11 @@
 #include "FlowEditorLogChannels.h"
 #include "FlowMessageLog.h"
 
+#include "Asset/FlowAssetAnalyzer.h"
 #include "Asset/FlowAssetEditorContext.h"
 #include "Asset/FlowAssetToolbar.h"
 #include "Asset/FlowMessageLogListing.h"
+#include "Graph/FlowGraph.h"
 #include "Graph/FlowGraphEditor.h"
 #include "Graph/FlowGraphSchema.h"
 #include "Graph/Widgets/SFlowPalette.h"
@@ -28,6 +30,7 @@
 #include "PropertyEditorModule.h"
 #include "ToolMenus.h"
 #include "Widgets/Docking/SDockTab.h"
+#include "Widgets/SNullWidget.h"
 
 #if ENABLE_SEARCH_IN_ASSET_EDITOR
 #include "Source/Private/Widgets/SSearchBrowser.h"
@@ -222,54 +225,87 @@ TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_Graph(const FSpawnTabArgs& Args)
 	return SpawnedTab;
 }
 
-TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_Palette(const FSpawnTabArgs& Args) const
+TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_Palette(const FSpawnTabArgs& Args)
 {
 	check(Args.GetTabId() == PaletteTab);
 
 	return SNew(SDockTab)
 		.Label(LOCTEXT("FlowPaletteTitle", "Palette"))
 		[
-			Palette.ToSharedRef()
+			GetTabContent(Palette, &FFlowAssetEditor::CreatePaletteWidget)
 		];
 }
 
-TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_RuntimeLog(const FSpawnTabArgs& Args) const
+TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_RuntimeLog(const FSpawnTabArgs& Args)
 {
 	check(Args.GetTabId() == RuntimeLogTab);
 
 	return SNew(SDockTab)
 		.Label(LOCTEXT("FlowRuntimeLogTitle", "Runtime Log"))
 		[
-			RuntimeLog.ToSharedRef()
+			GetTabContent(RuntimeLog, &FFlowAssetEditor::CreateRuntimeLogWidget)
 		];
 }
 
-TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_Search(const FSpawnTabArgs& Args) const
+TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_Search(const FSpawnTabArgs& Args)
 {
 	check(Args.GetTabId() == SearchTab);
 
+	// search is focused immediately after invoking tab, so it's created right away
 	return SNew(SDockTab)
 		.Label(LOCTEXT("FlowSearchTitle", "Search"))
 		[
 			SNew(SBox)
 			.AddMetaData<FTagMetaData>(FTagMetaData(TEXT("FlowSearch")))
 			[
-				SearchBrowser.ToSharedRef()
+				SearchBrowser.IsValid() ? StaticCastSharedRef<SWidget>(SearchBrowser.ToSharedRef()) : CreateSearchWidget()
 			]
 		];
 }
 
-TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_ValidationLog(const FSpawnTabArgs& Args) const
+TSharedRef<SDockTab> FFlowAssetEditor::SpawnTab_ValidationLog(const FSpawnTabArgs& Args)
 {
 	check(Args.GetTabId() == ValidationLogTab);
 
 	return SNew(SDockTab)
 		.Label(LOCTEXT("FlowValidationLogTitle", "Validation Log"))
 		[
-			ValidationLog.ToSharedRef()
+			GetTabContent(ValidationLog, &FFlowAssetEditor::CreateValidationLogWidget)
 		];
 }
 
+TSharedRef<SWidget> FFlowAssetEditor::GetTabContent(const TSharedPtr<SWidget>& Panel, TSharedRef<SWidget> (FFlowAssetEditor::*CreatePanel)())
+{
+	// tab might be reopened after its panel was created
+	if (Panel.IsValid())
+	{
+		return Panel.ToSharedRef();
+	}
+
+	return CreateLazyPanel([WeakThis = TWeakPtr<FFlowAssetEditor>(SharedThis(this)), CreatePanel]()
+	{
+		const TSharedPtr<FFlowAssetEditor> PinnedThis = WeakThis.Pin();
+		return PinnedThis.IsValid() ? (PinnedThis.Get()->*CreatePanel)() : SNullWidget::NullWidget;
+	});
+}
+
+TSharedRef<SWidget> FFlowAssetEditor::CreateLazyPanel(TFunction<TSharedRef<SWidget>()> CreatePanel)
+{
+	const TSharedRef<SBox> Placeholder = SNew(SBox);
+
+	// active timers are executed only for painted widgets, so this waits until tab is brought to the front
+	Placeholder->RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateLambda([WeakPlaceholder = TWeakPtr<SBox>(Placeholder), CreatePanel](double, float)
+	{
+		if (const TSharedPtr<SBox> PinnedPlaceholder = WeakPlaceholder.Pin())
+		{
+			PinnedPlaceholder->SetContent(CreatePanel());
+		}
+		return EActiveTimerReturnType::Stop;
+	}));
+
+	return Placeholder;
+}
+
 void FFlowAssetEditor::InitFlowAssetEditor(const EToolkitMode::Type Mode, const TSharedPtr<class IToolkitHost>& InitToolkitHost, UObject* ObjectToEdit)
 {
 	FlowAsset = CastChecked<UFlowAsset>(ObjectToEdit);
@@ -372,6 +408,10 @@ void FFlowAssetEditor::BindToolbarCommands()
 	ToolkitCommands->MapAction(ToolbarCommands.ValidateAsset,
 								FExecuteAction::CreateSP(this, &FFlowAssetEditor::ValidateAsset_Internal),
 								FCanExecuteAction());
+
+	ToolkitCommands->MapAction(ToolbarCommands.AnalyzeAsset,
+								FExecuteAction::CreateSP(this, &FFlowAssetEditor::AnalyzeAsset),
+								FCanExecuteAction());
 	
 	ToolkitCommands->MapAction(ToolbarCommands.SearchInAsset,
 								FExecuteAction::CreateSP(this, &FFlowAssetEditor::SearchInAsset),
@@ -395,7 +435,7 @@ void FFlowAssetEditor::BindToolbarCommands()
 void FFlowAssetEditor::RefreshAsset()
 {
 	// attempt to refresh graph, fix common issues automatically
-	CastChecked<UFlowGraph>(FlowAsset->GetGraph())->RefreshGraph();
+	UFlowGraph::GetReconstructedGraph(FlowAsset)->RefreshGraph();
 }
 
 void FFlowAssetEditor::ValidateAsset_Internal()
@@ -418,10 +458,28 @@ void FFlowAssetEditor::ValidateAsset(FFlowMessageLog& MessageLog)
 	FlowAsset->ValidateAsset(MessageLog);
 }
 
+void FFlowAssetEditor::AnalyzeAsset()
+{
+	const FFlowAssetComplexity Complexity = FFlowAssetAnalyzer::Analyze(FlowAsset);
+
+	FFlowMessageLog LogResults;
+	LogResults.Note<UFlowAsset>(*Complexity.ToString(), FlowAsset);
+	FFlowAssetAnalyzer::CheckBudgets(FlowAsset, Complexity, LogResults);
+
+	// reuse Validation Log window, metrics are always reported
+	ValidationLogListing->ClearMessages();
+	TabManager->TryInvokeTab(ValidationLogTab);
+	ValidationLogListing->AddMessages(LogResults.Messages);
+	ValidationLogListing->OnDataChanged().Broadcast();
+}
+
 void FFlowAssetEditor::SearchInAsset()
 {
 	TabManager->TryInvokeTab(SearchTab);
-	SearchBrowser->FocusForUse();
+	if (SearchBrowser.IsValid())
+	{
+		SearchBrowser->FocusForUse();
+	}
 }
 
 void FFlowAssetEditor::EditAssetDefaults_Clicked() const
@@ -462,28 +520,45 @@ void FFlowAssetEditor::CreateWidgets()
 	CreateGraphWidget();
 	GraphEditor->OnSelectionChangedEvent.BindRaw(this, &FFlowAssetEditor::OnSelectedNodesChanged);
 
-	// Palette
+	// Logs listings collect messages even if their tabs were never opened, widgets are created with tabs
+	{
+		RuntimeLogListing = FFlowMessageLogListing::GetLogListing(FlowAsset, EFlowLogType::Runtime);
+		RuntimeLogListing->OnMessageTokenClicked().AddSP(this, &FFlowAssetEditor::OnLogTokenClicked);
+	}
+	{
+		ValidationLogListing = FFlowMessageLogListing::GetLogListing(FlowAsset, EFlowLogType::Validation);
+		ValidationLogListing->OnMessageTokenClicked().AddSP(this, &FFlowAssetEditor::OnLogTokenClicked);
+	}
+}
+
+TSharedRef<SWidget> FFlowAssetEditor::CreatePaletteWidget()
+{
 	Palette = SNew(SFlowPalette, SharedThis(this));
+	return Palette.ToSharedRef();
+}
 
-	// Search
+TSharedRef<SWidget> FFlowAssetEditor::CreateSearchWidget()
+{
 #if ENABLE_SEARCH_IN_ASSET_EDITOR
 	SearchBrowser = SNew(SSearchBrowser, GetFlowAsset());
 #else
 	SearchBrowser = SNew(SFindInFlow, SharedThis(this));
 #endif
+	return SearchBrowser.ToSharedRef();
+}
 
-	// Logs
+TSharedRef<SWidget> FFlowAssetEditor::CreateRuntimeLogWidget()
+{
 	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
-	{
-		RuntimeLogListing = FFlowMessageLogListing::GetLogListing(FlowAsset, EFlowLogType::Runtime);
-		RuntimeLogListing->OnMessageTokenClicked().AddSP(this, &FFlowAssetEditor::OnLogTokenClicked);
-		RuntimeLog = MessageLogModule.CreateLogListingWidget(RuntimeLogListing.ToSharedRef());
-	}
-	{
-		ValidationLogListing = FFlowMessageLogListing::GetLogListing(FlowAsset, EFlowLogType::Validation);
-		ValidationLogListing->OnMessageTokenClicked().AddSP(this, &FFlowAssetEditor::OnLogTokenClicked);
-		ValidationLog = MessageLogModule.CreateLogListingWidget(ValidationLogListing.ToSharedRef());
-	}
+	RuntimeLog = MessageLogModule.CreateLogListingWidget(RuntimeLogListing.ToSharedRef());
+	return RuntimeLog.ToSharedRef();
+}
+
+TSharedRef<SWidget> FFlowAssetEditor::CreateValidationLogWidget()
+{
+	FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
+	ValidationLog = MessageLogModule.CreateLogListingWidget(ValidationLogListing.ToSharedRef());
+	return ValidationLog.ToSharedRef();
 }
 
 void FFlowAssetEditor::CreateGraphWidget()
@@ -5,6 +5,7 @@
 #include "FlowAsset.h"
 #include "Nodes/FlowNode.h"
 
+#include "Graph/FlowGraph.h"
 #include "Graph/Nodes/FlowGraphNode_Reroute.h"
 
 #include "EdGraph/EdGraph.h"
@@ -51,7 +52,7 @@ void FFlowAssetIndexer::IndexAsset(const UObject* InAssetObject, FSearchSerializ
 
 void FFlowAssetIndexer::IndexGraph(const UFlowAsset* InFlowAsset, FSearchSerializer& Serializer) const
 {
-	for (UEdGraphNode* Node : InFlowAsset->GetGraph()->Nodes)
+	for (UEdGraphNode* Node : UFlowGraph::GetReconstructedGraph(InFlowAsset)->Nodes)
 	{
 		// Ignore Reroutes
 		if (Cast<UFlowGraphNode_Reroute>(Node))
@@ -37,7 +37,7 @@ void SFlowAssetInstanceList::Construct(const FArguments& InArgs, const TWeakObje
 	TemplateAsset = InTemplateAsset;
 	if (TemplateAsset.IsValid())
 	{
-		TemplateAsset->OnDebuggerRefresh().AddSP(this, &SFlowAssetInstanceList::RefreshInstances);
+		TemplateAsset->OnDebuggerRefresh().AddSP(this, &SFlowAssetInstanceList::RequestRefreshInstances);
 		RefreshInstances();
 	}
 
@@ -92,6 +92,27 @@ void SFlowAssetInstanceList::RefreshInstances()
 	}
 }
 
+void SFlowAssetInstanceList::RequestRefreshInstances()
+{
+	// active timers run only for painted widgets, many refresh events are handled by a single refresh
+	if (!bRefreshPending)
+	{
+		bRefreshPending = true;
+		RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SFlowAssetInstanceList::HandleRefreshInstances));
+	}
+}
+
+EActiveTimerReturnType SFlowAssetInstanceList::HandleRefreshInstances(double InCurrentTime, float InDeltaTime)
+{
+	bRefreshPending = false;
+	if (TemplateAsset.IsValid())
+	{
+		RefreshInstances();
+	}
+
+	return EActiveTimerReturnType::Stop;
+}
+
 EVisibility SFlowAssetInstanceList::GetDebuggerVisibility()
 {
 	return GEditor->PlayWorld ? EVisibility::Visible : EVisibility::Collapsed;
@@ -202,6 +223,7 @@ void FFlowAssetToolbar::BuildAssetToolbar(UToolMenu* ToolbarMenu) const
 		// add buttons
 		Section.AddEntry(FToolMenuEntry::InitToolBarButton(FFlowToolbarCommands::Get().RefreshAsset));
 		Section.AddEntry(FToolMenuEntry::InitToolBarButton(FFlowToolbarCommands::Get().ValidateAsset));
+		Section.AddEntry(FToolMenuEntry::InitToolBarButton(FFlowToolbarCommands::Get().AnalyzeAsset));
 		Section.AddEntry(FToolMenuEntry::InitToolBarButton(FFlowToolbarCommands::Get().EditAssetDefaults));
 	}
 	
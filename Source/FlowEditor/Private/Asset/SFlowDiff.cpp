@@ -2,6 +2,7 @@
 
 #include "Asset/SFlowDiff.h"
 #include "Asset/FlowDiffControl.h"
+#include "Graph/FlowGraph.h"
 
 #include "FlowAsset.h"
 
@@ -748,7 +749,7 @@ SFlowDiff::FDiffControl SFlowDiff::GenerateDetailsPanel()
 SFlowDiff::FDiffControl SFlowDiff::GenerateGraphPanel()
 {
 	// We only have a single permanent graph in Flow Asset
-	GraphToDiff = MakeShared<FFlowGraphToDiff>(this, PanelOld.FlowAsset->GetGraph(), PanelNew.FlowAsset->GetGraph(), PanelOld.RevisionInfo, PanelNew.RevisionInfo);
+	GraphToDiff = MakeShared<FFlowGraphToDiff>(this, UFlowGraph::GetReconstructedGraph(PanelOld.FlowAsset), UFlowGraph::GetReconstructedGraph(PanelNew.FlowAsset), PanelOld.RevisionInfo, PanelNew.RevisionInfo);
 	GraphToDiff->GenerateTreeEntries(PrimaryDifferencesList, RealDifferences);
 	
 	FDiffControl Ret;
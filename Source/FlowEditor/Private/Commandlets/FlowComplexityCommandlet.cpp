@@ -0,0 +1,81 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Commandlets/FlowComplexityCommandlet.h"
+#include "Asset/FlowAssetAnalyzer.h"
+#include "FlowEditorLogChannels.h"
+
+#include "FlowAsset.h"
+#include "FlowMessageLog.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Logging/TokenizedMessage.h"
+#include "Modules/ModuleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowComplexityCommandlet)
+
+UFlowComplexityCommandlet::UFlowComplexityCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UFlowComplexityCommandlet::Main(const FString& Params)
+{
+	FString SearchPath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), SearchPath);
+
+	int32 BatchSize = 50;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(1, BatchSize);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UFlowAsset::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.PackagePaths.Add(FName(*SearchPath));
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> FoundAssets;
+	AssetRegistry.GetAssets(Filter, FoundAssets);
+
+	int32 AssetsOverBudget = 0;
+	for (int32 BatchStart = 0; BatchStart < FoundAssets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, FoundAssets.Num());
+		bool bLoadedAnyAsset = false;
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; AssetIndex++)
+		{
+			const FAssetData& AssetData = FoundAssets[AssetIndex];
+
+			// asset is loaded only if metrics aren't cached yet
+			const FFlowAssetComplexity Complexity = FFlowAssetAnalyzer::AnalyzeCached(AssetData);
+			UE_LOG(LogFlowEditor, Display, TEXT("%s: %s"), *AssetData.GetObjectPathString(), *Complexity.ToString());
+
+			FFlowMessageLog LogResults;
+			if (!FFlowAssetAnalyzer::CheckBudgets(nullptr, Complexity, LogResults))
+			{
+				AssetsOverBudget++;
+				for (const TSharedRef<FTokenizedMessage>& Message : LogResults.Messages)
+				{
+					UE_LOG(LogFlowEditor, Warning, TEXT("%s: %s"), *AssetData.GetObjectPathString(), *Message->ToText().ToString());
+				}
+			}
+
+			bLoadedAnyAsset |= FindObject<UFlowAsset>(nullptr, *AssetData.GetObjectPathString()) != nullptr;
+		}
+
+		// release loaded assets before loading the next batch, there's nothing to release if all metrics were cached
+		if (bLoadedAnyAsset)
+		{
+			CollectGarbage(RF_NoFlags);
+		}
+	}
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Analyzed %d Flow Assets, %d exceeded complexity budgets"), FoundAssets.Num(), AssetsOverBudget);
+	return AssetsOverBudget > 0 ? 1 : 0;
+}
@@ -0,0 +1,281 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Commandlets/FlowNodeReplaceCommandlet.h"
+#include "FlowEditorLogChannels.h"
+#include "Graph/FlowGraph.h"
+#include "Graph/FlowGraphSchema_Actions.h"
+#include "Graph/Nodes/FlowGraphNode.h"
+
+#include "FlowAsset.h"
+#include "FlowMessageLog.h"
+#include "Nodes/FlowNode.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Engine.h"
+#include "Logging/TokenizedMessage.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowNodeReplaceCommandlet)
+
+UFlowNodeReplaceCommandlet::UFlowNodeReplaceCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UFlowNodeReplaceCommandlet::Main(const FString& Params)
+{
+	FString FromClassPath;
+	if (!FParse::Value(*Params, TEXT("From="), FromClassPath))
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("Missing -From= parameter"));
+		return 1;
+	}
+
+	const UClass* FromClass = LoadObject<UClass>(nullptr, *FromClassPath);
+	if (FromClass == nullptr || !FromClass->IsChildOf(UFlowNode::StaticClass()))
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("%s isn't a Flow Node class"), *FromClassPath);
+		return 1;
+	}
+
+	const UClass* ToClass = nullptr;
+	FString ToClassPath;
+	if (FParse::Value(*Params, TEXT("To="), ToClassPath))
+	{
+		ToClass = LoadObject<UClass>(nullptr, *ToClassPath);
+		if (ToClass == nullptr || !ToClass->IsChildOf(UFlowNode::StaticClass()) || ToClass->HasAnyClassFlags(CLASS_Abstract))
+		{
+			UE_LOG(LogFlowEditor, Error, TEXT("%s isn't a non-abstract Flow Node class"), *ToClassPath);
+			return 1;
+		}
+	}
+
+	// -Pins=OldName:NewName,OtherOldName:OtherNewName
+	TMap<FName, FName> PinRedirects;
+	FString PinsParam;
+	if (FParse::Value(*Params, TEXT("Pins="), PinsParam, false))
+	{
+		TArray<FString> PinPairs;
+		PinsParam.ParseIntoArray(PinPairs, TEXT(","));
+		for (const FString& PinPair : PinPairs)
+		{
+			FString OldPinName;
+			FString NewPinName;
+			if (PinPair.Split(TEXT(":"), &OldPinName, &NewPinName))
+			{
+				PinRedirects.Emplace(*OldPinName.TrimStartAndEnd(), *NewPinName.TrimStartAndEnd());
+			}
+			else
+			{
+				UE_LOG(LogFlowEditor, Error, TEXT("Invalid pin redirect %s, expected OldName:NewName"), *PinPair);
+				return 1;
+			}
+		}
+	}
+
+	if ((ToClass == nullptr || ToClass == FromClass) && PinRedirects.Num() == 0)
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("Nothing to do, provide -To= class or -Pins= redirects"));
+		return 1;
+	}
+
+	FString SearchPath = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), SearchPath);
+
+	int32 BatchSize = 50;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(1, BatchSize);
+
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UFlowAsset::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.PackagePaths.Add(FName(*SearchPath));
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> FoundAssets;
+	AssetRegistry.GetAssets(Filter, FoundAssets);
+
+	// only assets referencing package of the node class can contain this node, so we don't have to load everything
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(FromClass->GetPackage()->GetFName(), Referencers);
+	if (Referencers.Num() == 0)
+	{
+		UE_LOG(LogFlowEditor, Display, TEXT("Nothing to do, no asset references %s"), *FromClass->GetPackage()->GetName());
+		return 0;
+	}
+
+	const TSet<FName> ReferencerSet(Referencers);
+	FoundAssets.RemoveAll([&ReferencerSet](const FAssetData& AssetData)
+	{
+		return !ReferencerSet.Contains(AssetData.PackageName);
+	});
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Found %d Flow Assets which might use %s"), FoundAssets.Num(), *FromClass->GetName());
+
+	int32 ReplacedNodes = 0;
+	int32 ModifiedAssets = 0;
+	int32 FailedAssets = 0;
+
+	for (int32 BatchStart = 0; BatchStart < FoundAssets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, FoundAssets.Num());
+		for (int32 AssetIndex = BatchStart; AssetIndex < BatchEnd; AssetIndex++)
+		{
+			const FAssetData& AssetData = FoundAssets[AssetIndex];
+			UFlowAsset* FlowAsset = Cast<UFlowAsset>(AssetData.GetAsset());
+			if (FlowAsset == nullptr)
+			{
+				UE_LOG(LogFlowEditor, Warning, TEXT("Failed to load %s"), *AssetData.GetObjectPathString());
+				FailedAssets++;
+				continue;
+			}
+
+			const int32 AssetReplacedNodes = ReplaceNodes(FlowAsset, FromClass, ToClass, PinRedirects);
+			if (AssetReplacedNodes == 0)
+			{
+				continue;
+			}
+
+			ReplacedNodes += AssetReplacedNodes;
+			UE_LOG(LogFlowEditor, Display, TEXT("%s: replaced %d nodes"), *AssetData.GetObjectPathString(), AssetReplacedNodes);
+
+			// don't save asset broken by the refactor, it has to be fixed by hand
+			FFlowMessageLog ValidationLog;
+			if (FlowAsset->ValidateAsset(ValidationLog) == EDataValidationResult::Invalid)
+			{
+				for (const TSharedRef<FTokenizedMessage>& Message : ValidationLog.Messages)
+				{
+					UE_LOG(LogFlowEditor, Warning, TEXT("%s: %s"), *AssetData.GetObjectPathString(), *Message->ToText().ToString());
+				}
+
+				UE_LOG(LogFlowEditor, Error, TEXT("%s failed validation after replacing nodes, skipped saving"), *AssetData.GetObjectPathString());
+				FailedAssets++;
+				continue;
+			}
+
+			if (bDryRun)
+			{
+				ModifiedAssets++;
+				continue;
+			}
+
+			UPackage* Package = FlowAsset->GetPackage();
+			const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+			if (UPackage::SavePackage(Package, FlowAsset, *Filename, SaveArgs))
+			{
+				ModifiedAssets++;
+			}
+			else
+			{
+				UE_LOG(LogFlowEditor, Error, TEXT("Failed to save %s, make sure it's checked out"), *Filename);
+				FailedAssets++;
+			}
+		}
+
+		// release loaded assets before loading the next batch
+		CollectGarbage(RF_NoFlags);
+	}
+
+	UE_LOG(LogFlowEditor, Display, TEXT("Replaced %d nodes in %d Flow Assets%s, %d assets failed"), ReplacedNodes, ModifiedAssets, bDryRun ? TEXT(" (dry run, nothing saved)") : TEXT(""), FailedAssets);
+	return FailedAssets > 0 ? 1 : 0;
+}
+
+int32 UFlowNodeReplaceCommandlet::ReplaceNodes(UFlowAsset* FlowAsset, const UClass* FromClass, const UClass* ToClass, const TMap<FName, FName>& PinRedirects) const
+{
+	UFlowGraph* FlowGraph = UFlowGraph::GetReconstructedGraph(FlowAsset);
+	if (FlowGraph == nullptr)
+	{
+		return 0;
+	}
+
+	// copy, replacing nodes modifies the map
+	TArray<UFlowNode*> NodesToReplace;
+	for (const TPair<FGuid, UFlowNode*>& Node : FlowAsset->GetNodes())
+	{
+		if (Node.Value && Node.Value->GetClass() == FromClass)
+		{
+			NodesToReplace.Add(Node.Value);
+		}
+	}
+
+	int32 ReplacedNodes = 0;
+	for (UFlowNode* OldNode : NodesToReplace)
+	{
+		UFlowGraphNode* GraphNode = Cast<UFlowGraphNode>(OldNode->GetGraphNode());
+		if (GraphNode == nullptr)
+		{
+			continue;
+		}
+
+		// renamed graph pins are matched by name with pins of the new node, so connections are kept
+		for (UEdGraphPin* Pin : GraphNode->Pins)
+		{
+			if (const FName* NewPinName = PinRedirects.Find(Pin->PinName))
+			{
+				Pin->PinName = *NewPinName;
+			}
+		}
+
+		// user-added pins are recreated from the node, and copied to the new node class
+		for (TArray<FFlowPin>* NodePins : {&OldNode->InputPins, &OldNode->OutputPins})
+		{
+			for (FFlowPin& NodePin : *NodePins)
+			{
+				if (const FName* NewPinName = PinRedirects.Find(NodePin.PinName))
+				{
+					NodePin.PinName = *NewPinName;
+				}
+			}
+		}
+
+		if (ToClass && ToClass != FromClass)
+		{
+			UFlowNode* NewNode = ReplaceNodeClass(FlowAsset, OldNode, ToClass);
+			FFlowGraphSchemaAction_NewNode::RecreateNode(FlowGraph, GraphNode, NewNode);
+		}
+		else
+		{
+			GraphNode->ReconstructNode();
+		}
+
+		ReplacedNodes++;
+	}
+
+	if (ReplacedNodes > 0)
+	{
+		FlowGraph->NotifyGraphChanged();
+		FlowAsset->MarkPackageDirty();
+	}
+
+	return ReplacedNodes;
+}
+
+UFlowNode* UFlowNodeReplaceCommandlet::ReplaceNodeClass(UFlowAsset* FlowAsset, UFlowNode* OldNode, const UClass* ToClass) const
+{
+	UFlowNode* NewNode = NewObject<UFlowNode>(FlowAsset, ToClass, NAME_None, RF_Transactional);
+
+	// keep values of properties existing in both classes
+	UEngine::CopyPropertiesForUnrelatedObjects(OldNode, NewNode);
+
+	const FGuid NodeGuid = OldNode->GetGuid();
+	FlowAsset->UnregisterNode(NodeGuid);
+	OldNode->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional);
+	OldNode->MarkAsGarbage();
+
+	FlowAsset->RegisterNode(NodeGuid, NewNode);
+	return NewNode;
+}
@@ -0,0 +1,151 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Commandlets/FlowRegistryProxyCommandlet.h"
+#include "FlowEditorLogChannels.h"
+
+#include "FlowComponent.h"
+#include "FlowWorldSettings.h"
+
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowRegistryProxyCommandlet)
+
+UFlowRegistryProxyCommandlet::UFlowRegistryProxyCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UFlowRegistryProxyCommandlet::Main(const FString& Params)
+{
+	FString MapName;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("Missing -Map= parameter"));
+		return 1;
+	}
+
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (World == nullptr)
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("Failed to load map %s"), *MapName);
+		return 1;
+	}
+
+	AFlowWorldSettings* WorldSettings = Cast<AFlowWorldSettings>(World->GetWorldSettings());
+	if (WorldSettings == nullptr)
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("Map %s doesn't use Flow World Settings"), *MapName);
+		return 1;
+	}
+
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true));
+	}
+
+	UWorldPartition* WorldPartition = World->GetWorldPartition();
+	if (WorldPartition == nullptr)
+	{
+		UE_LOG(LogFlowEditor, Display, TEXT("Map %s isn't partitioned, there is nothing to stream in"), *MapName);
+		WorldSettings->ComponentProxies.Empty();
+	}
+	else
+	{
+		if (!WorldPartition->IsInitialized())
+		{
+			WorldPartition->Initialize(World, FTransform::Identity);
+		}
+
+		TArray<FFlowComponentProxy> Proxies;
+		int32 FailedActorSaves = 0;
+
+		// callback receives Actor Desc or Actor Desc Instance, depending on engine version
+		FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, AActor::StaticClass(), [&Proxies, &FailedActorSaves](const auto* ActorDesc)
+		{
+			// always loaded actors are registered as regular components
+			if (!ActorDesc->GetIsSpatiallyLoaded())
+			{
+				return true;
+			}
+
+			if (AActor* Actor = ActorDesc->GetActor())
+			{
+				UFlowComponent* FlowComponent = Actor->FindComponentByClass<UFlowComponent>();
+				if (FlowComponent && FlowComponent->IdentityTags.IsValid())
+				{
+					// component finds its proxy by this Guid at runtime, actors are unloaded in batches so save it right away
+					if (FlowComponent->ProxyGuid != ActorDesc->GetGuid())
+					{
+						FlowComponent->Modify();
+						FlowComponent->ProxyGuid = ActorDesc->GetGuid();
+
+						UPackage* ActorPackage = Actor->GetExternalPackage() ? Actor->GetExternalPackage() : Actor->GetPackage();
+						const FString ActorFilename = FPackageName::LongPackageNameToFilename(ActorPackage->GetName(), FPackageName::GetAssetPackageExtension());
+						FSavePackageArgs ActorSaveArgs;
+						ActorSaveArgs.TopLevelFlags = RF_Standalone;
+						if (!UPackage::SavePackage(ActorPackage, nullptr, *ActorFilename, ActorSaveArgs))
+						{
+							UE_LOG(LogFlowEditor, Error, TEXT("Failed to save %s, make sure it's checked out"), *ActorFilename);
+							FailedActorSaves++;
+						}
+					}
+
+					Proxies.Emplace(FlowComponent->IdentityTags, ActorDesc->GetGuid(), Actor->GetActorLocation(), TSoftObjectPtr<AActor>(ActorDesc->GetActorSoftPath()));
+				}
+			}
+
+			return true;
+		});
+
+		if (FailedActorSaves > 0)
+		{
+			UE_LOG(LogFlowEditor, Error, TEXT("Failed to save %d actors, their Flow Components won't find proxies at runtime"), FailedActorSaves);
+		}
+
+		// keep output stable between runs
+		Proxies.Sort([](const FFlowComponentProxy& A, const FFlowComponentProxy& B)
+		{
+			return A.ActorGuid < B.ActorGuid;
+		});
+
+		WorldSettings->ComponentProxies = Proxies;
+		UE_LOG(LogFlowEditor, Display, TEXT("Gathered %d Flow Component proxies in %s"), Proxies.Num(), *MapName);
+	}
+
+	WorldSettings->Modify();
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetMapPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Standalone;
+	const bool bSaved = UPackage::SavePackage(Package, World, *Filename, SaveArgs);
+
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+
+	if (!bSaved)
+	{
+		UE_LOG(LogFlowEditor, Error, TEXT("Failed to save %s, make sure it's checked out"), *Filename);
+		return 1;
+	}
+
+	return 0;
+}
@@ -4,6 +4,7 @@
 #include "FlowAsset.h"
 #include "Asset/FlowAssetEditor.h"
 #include "EdGraph/EdGraph.h"
+#include "Graph/FlowGraph.h"
 #include "Graph/FlowGraphEditor.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Framework/Application/SlateApplication.h"
@@ -310,9 +311,9 @@ void SFindInFlow::MatchTokens(const TArray<FString>& Tokens)
 			UFlowNode_SubGraph* SubGraphNode = Cast<UFlowNode_SubGraph>(FlowGraphNode->GetFlowNode());
 			if (bFindInSubGraph && SubGraphNode)
 			{
-				if (const UFlowAsset* FlowAsset = Cast<UFlowAsset>(SubGraphNode->GetAssetToEdit()); FlowAsset && FlowAsset->GetGraph())
+				if (const UFlowGraph* SubGraph = UFlowGraph::GetReconstructedGraph(Cast<UFlowAsset>(SubGraphNode->GetAssetToEdit())))
 				{
-					for (auto ChildIt(FlowAsset->GetGraph()->Nodes.CreateConstIterator()); ChildIt; ++ChildIt)
+					for (auto ChildIt(SubGraph->Nodes.CreateConstIterator()); ChildIt; ++ChildIt)
 					{
 						MatchTokensInChild(Tokens, *ChildIt, NodeResult);
 					}
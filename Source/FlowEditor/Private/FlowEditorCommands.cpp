@@ -20,6 +20,7 @@ void FFlowToolbarCommands::RegisterCommands()
 {
 	UI_COMMAND(RefreshAsset, "Refresh", "Refresh asset and all nodes", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(ValidateAsset, "Validate", "Validate asset and all nodes", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(AnalyzeAsset, "Analyze", "Compute complexity metrics and compare them against budgets from Flow Graph Settings", EUserInterfaceActionType::Button, FInputChord());
 
 	UI_COMMAND(SearchInAsset, "Search", "Search in the current Flow Graph", EUserInterfaceActionType::Button, FInputChord(EModifierKey::Control | EModifierKey::Shift, EKeys::F));
 	UI_COMMAND(EditAssetDefaults, "Asset Defaults", "Edit the FlowAsset default properties", EUserInterfaceActionType::Button, FInputChord());
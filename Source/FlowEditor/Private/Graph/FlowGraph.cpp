@@ -9,6 +9,7 @@
 
 #include "Editor.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "TimerManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(FlowGraph)
 
@@ -71,20 +72,110 @@ void UFlowGraph::RefreshGraph()
 		// refresh nodes
 		TArray<UFlowGraphNode*> FlowGraphNodes;
 		GetNodesOfClass<UFlowGraphNode>(FlowGraphNodes);
+		{
+			TGuardValue<bool> BatchGuard(bBatchingGraphChanges, true);
+			for (UFlowGraphNode* GraphNode : FlowGraphNodes)
+			{
+				GraphNode->OnGraphRefresh();
+			}
+		}
+
+		if (bGraphChangedWhileBatching)
+		{
+			bGraphChangedWhileBatching = false;
+			NotifyGraphChanged();
+		}
+	}
+}
+
+UFlowGraph* UFlowGraph::GetReconstructedGraph(const UFlowAsset* FlowAsset)
+{
+	UFlowGraph* FlowGraph = FlowAsset ? Cast<UFlowGraph>(FlowAsset->GetGraph()) : nullptr;
+	if (FlowGraph)
+	{
+		FlowGraph->ReconstructDeferredNodes();
+	}
+
+	return FlowGraph;
+}
+
+void UFlowGraph::ReconstructDeferredNodes()
+{
+	TArray<UFlowGraphNode*> FlowGraphNodes;
+	GetNodesOfClass<UFlowGraphNode>(FlowGraphNodes);
+
+	FlowGraphNodes.RemoveAll([](const UFlowGraphNode* GraphNode)
+	{
+		return !GraphNode->IsReconstructionDeferred();
+	});
+	if (FlowGraphNodes.Num() == 0)
+	{
+		return;
+	}
+
+	// it's the same fixup that used to happen on load, it shouldn't mark asset as modified by user
+	UPackage* Package = GetPackage();
+	const bool bWasDirty = Package->IsDirty();
+
+	{
+		TGuardValue<bool> BatchGuard(bBatchingGraphChanges, true);
 		for (UFlowGraphNode* GraphNode : FlowGraphNodes)
 		{
-			GraphNode->OnGraphRefresh();
+			GraphNode->ReconstructNode();
 		}
 	}
+	bGraphChangedWhileBatching = false;
+
+	GetFlowAsset()->HarvestNodeConnections();
+
+	if (!bWasDirty)
+	{
+		Package->SetDirtyFlag(false);
+	}
 }
 
 void UFlowGraph::NotifyGraphChanged()
 {
+	if (bBatchingGraphChanges)
+	{
+		bGraphChangedWhileBatching = true;
+		return;
+	}
+
 	GetFlowAsset()->HarvestNodeConnections();
 
 	Super::NotifyGraphChanged();
 }
 
+void UFlowGraph::RequestNodeReconstruction(UFlowGraphNode* GraphNode)
+{
+	// reconstruct right away, so pin changes are recorded by the transaction that modified the node
+	GraphNode->ReconstructNode();
+
+	if (!bGraphChangeScheduled)
+	{
+		// no editor ticking, i.e. while running commandlet
+		if (GEditor == nullptr)
+		{
+			NotifyGraphChanged();
+			return;
+		}
+
+		// editing property on many selected nodes calls this once per node, let's refresh graph only once
+		bGraphChangeScheduled = true;
+		GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UFlowGraph::FlushPendingGraphChange));
+	}
+}
+
+void UFlowGraph::FlushPendingGraphChange()
+{
+	if (bGraphChangeScheduled)
+	{
+		bGraphChangeScheduled = false;
+		NotifyGraphChanged();
+	}
+}
+
 UFlowAsset* UFlowGraph::GetFlowAsset() const
 {
 	return GetTypedOuter<UFlowAsset>();
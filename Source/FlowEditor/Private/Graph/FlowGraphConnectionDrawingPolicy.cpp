@@ -64,7 +64,7 @@ void FFlowGraphConnectionDrawingPolicy::BuildPaths()
 
 			for (const TPair<uint8, FPinRecord>& Record : Node->GetWireRecords())
 			{
-				if (UEdGraphPin* OutputPin = FlowGraphNode->OutputPins[Record.Key])
+				if (UEdGraphPin* OutputPin = FlowGraphNode->GetOutputPins()[Record.Key])
 				{
 					// check if Output pin is connected to anything
 					if (OutputPin->LinkedTo.Num() > 0)
@@ -307,7 +307,7 @@ bool FFlowGraphConnectionDrawingPolicy::ShouldChangeTangentForReroute(UFlowGraph
 		FVector2D AverageLeftPin;
 		FVector2D AverageRightPin;
 		FVector2D CenterPin;
-		const bool bCenterValid = Reroute->OutputPins.Num() == 0 ? false : FindPinCenter(Reroute->OutputPins[0], /*out*/ CenterPin);
+		const bool bCenterValid = Reroute->GetOutputPins().Num() == 0 ? false : FindPinCenter(Reroute->GetOutputPins()[0], /*out*/ CenterPin);
 		const bool bLeftValid = GetAverageConnectedPosition(Reroute, EGPD_Input, /*out*/ AverageLeftPin);
 		const bool bRightValid = GetAverageConnectedPosition(Reroute, EGPD_Output, /*out*/ AverageRightPin);
 
@@ -352,12 +352,12 @@ bool FFlowGraphConnectionDrawingPolicy::GetAverageConnectedPosition(UFlowGraphNo
 	FVector2D Result = FVector2D::ZeroVector;
 	int32 ResultCount = 0;
 
-	if(Reroute->InputPins.Num() == 0 || Reroute->OutputPins.Num() == 0)
+	if(Reroute->GetInputPins().Num() == 0 || Reroute->GetOutputPins().Num() == 0)
 	{
 		return false;
 	}
 	
-	UEdGraphPin* Pin = (Direction == EGPD_Input) ? Reroute->InputPins[0] : Reroute->OutputPins[0];
+	UEdGraphPin* Pin = (Direction == EGPD_Input) ? Reroute->GetInputPins()[0] : Reroute->GetOutputPins()[0];
 	for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
 	{
 		FVector2D CenterPoint;
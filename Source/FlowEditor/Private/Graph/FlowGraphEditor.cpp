@@ -6,6 +6,7 @@
 
 #include "Asset/FlowAssetEditor.h"
 #include "Asset/FlowDebuggerSubsystem.h"
+#include "Graph/FlowGraph.h"
 #include "Graph/FlowGraphEditorSettings.h"
 #include "Graph/FlowGraphSchema_Actions.h"
 #include "Graph/Nodes/FlowGraphNode.h"
@@ -37,7 +38,7 @@ void SFlowGraphEditor::Construct(const FArguments& InArgs, const TSharedPtr<FFlo
 	SGraphEditor::FArguments Arguments;
 	Arguments._AdditionalCommands = CommandList;
 	Arguments._Appearance = GetGraphAppearanceInfo();
-	Arguments._GraphToEdit = FlowAsset->GetGraph();
+	Arguments._GraphToEdit = UFlowGraph::GetReconstructedGraph(FlowAsset.Get());
 	Arguments._GraphEvents = InArgs._GraphEvents;
 	Arguments._AutoExpandActionMenu = true;
 	Arguments._GraphEvents.OnSelectionChanged = FOnSelectionChanged::CreateSP(this, &SFlowGraphEditor::OnSelectedNodesChanged);
@@ -388,7 +389,7 @@ void SFlowGraphEditor::ReconnectExecPins(const UFlowGraphNode* Node)
 	UEdGraphPin* InputPin = nullptr;
 	UEdGraphPin* OutputPin = nullptr;
 
-	for (UEdGraphPin* Pin : Node->InputPins)
+	for (UEdGraphPin* Pin : Node->GetInputPins())
 	{
 		if (Pin->HasAnyConnections())
 		{
@@ -410,7 +411,7 @@ void SFlowGraphEditor::ReconnectExecPins(const UFlowGraphNode* Node)
 		}
 	}
 
-	for (UEdGraphPin* Pin : Node->OutputPins)
+	for (UEdGraphPin* Pin : Node->GetOutputPins())
 	{
 		if (Pin->HasAnyConnections())
 		{
@@ -48,6 +48,7 @@ void UFlowGraphSchema::SubscribeToAssetChanges()
 	AssetRegistry.Get().OnAssetRemoved().AddStatic(&UFlowGraphSchema::OnAssetRemoved);
 
 	FCoreUObjectDelegates::ReloadCompleteDelegate.AddStatic(&UFlowGraphSchema::OnHotReload);
+	UFlowGraphNode::SubscribeToPropertyChanges();
 
 	if (GEditor)
 	{
@@ -253,8 +254,8 @@ void UFlowGraphSchema::OnPinConnectionDoubleCicked(UEdGraphPin* PinA, UEdGraphPi
 	UFlowGraphNode* NewReroute = FFlowGraphSchemaAction_NewNode::CreateNode(ParentGraph, nullptr, UFlowNode_Reroute::StaticClass(), KnotTopLeft, false);
 
 	PinA->BreakLinkTo(PinB);
-	PinA->MakeLinkTo((PinA->Direction == EGPD_Output) ? NewReroute->InputPins[0] : NewReroute->OutputPins[0]);
-	PinB->MakeLinkTo((PinB->Direction == EGPD_Output) ? NewReroute->InputPins[0] : NewReroute->OutputPins[0]);
+	PinA->MakeLinkTo((PinA->Direction == EGPD_Output) ? NewReroute->GetInputPins()[0] : NewReroute->GetOutputPins()[0]);
+	PinB->MakeLinkTo((PinB->Direction == EGPD_Output) ? NewReroute->GetInputPins()[0] : NewReroute->GetOutputPins()[0]);
 }
 
 TArray<TSharedPtr<FString>> UFlowGraphSchema::GetFlowNodeCategories()
@@ -448,6 +449,7 @@ void UFlowGraphSchema::OnBlueprintCompiled()
 	if (bBlueprintCompilationPending)
 	{
 		GatherNodes();
+		UFlowGraphNode::InvalidateAllDisplayCaches();
 	}
 
 	bBlueprintCompilationPending = false;
@@ -456,6 +458,7 @@ void UFlowGraphSchema::OnBlueprintCompiled()
 void UFlowGraphSchema::OnHotReload(EReloadCompleteReason ReloadCompleteReason)
 {
 	GatherNodes();
+	UFlowGraphNode::InvalidateAllDisplayCaches();
 }
 
 void UFlowGraphSchema::GatherNativeNodes()
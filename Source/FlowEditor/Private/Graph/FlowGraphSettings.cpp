@@ -33,6 +33,12 @@ UFlowGraphSettings::UFlowGraphSettings(const FObjectInitializer& ObjectInitializ
 	, RecordedWireThickness(3.5f)
 	, SelectedWireColor(FLinearColor(0.984f, 0.482f, 0.010f, 1.0f))
 	, SelectedWireThickness(1.5f)
+	, MaxNodeCount(500)
+	, MaxSynchronousChainDepth(50)
+	, MaxObserverNodeCount(50)
+	, MaxSubGraphDepth(8)
+	, MaxInstanceMemory(0)
+	, MaxSaveSize(0)
 {
 	NodeTitleColors.Emplace(EFlowNodeStyle::Condition, FLinearColor(1.0f, 0.62f, 0.016f, 1.0f));
 	NodeTitleColors.Emplace(EFlowNodeStyle::Default, FLinearColor(-0.728f, 0.581f, 1.0f, 1.0f));
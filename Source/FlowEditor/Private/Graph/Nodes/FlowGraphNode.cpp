@@ -11,8 +11,10 @@
 #include "Graph/Widgets/SFlowGraphNode.h"
 
 #include "FlowAsset.h"
+#include "FlowSettings.h"
 #include "Nodes/FlowNode.h"
 
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "Developer/ToolMenus/Public/ToolMenus.h"
 #include "EdGraph/EdGraphSchema.h"
 #include "EdGraphSchema_K2.h"
@@ -31,11 +33,16 @@
 
 #define LOCTEXT_NAMESPACE "FlowGraphNode"
 
+uint32 UFlowGraphNode::DisplayCacheGeneration = 1;
+FDelegateHandle UFlowGraphNode::ObjectPropertyChangedHandle;
+
 UFlowGraphNode::UFlowGraphNode(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, FlowNode(nullptr)
 	, bBlueprintCompilationPending(false)
 	, bNeedsFullReconstruction(false)
+	, bReconstructionDeferred(false)
+	, ContextPinsFingerprint(0)
 {
 	OrphanedPinSaveMode = ESaveOrphanPinMode::SaveAll;
 }
@@ -43,6 +50,7 @@ UFlowGraphNode::UFlowGraphNode(const FObjectInitializer& ObjectInitializer)
 void UFlowGraphNode::SetNodeTemplate(UFlowNode* InFlowNode)
 {
 	FlowNode = InFlowNode;
+	InvalidateDisplayCache();
 }
 
 const UFlowNode* UFlowGraphNode::GetNodeTemplate() const
@@ -75,7 +83,16 @@ void UFlowGraphNode::PostLoad()
 		SubscribeToExternalChanges();
 	}
 
-	ReconstructNode();
+	// rebuilding pins might load assets providing context pins, don't pay for it until graph is opened, diffed or searched
+	// nodes with breakpoints need pins while debugging, even if graph isn't opened
+	if (PinBreakpoints.Num() == 0)
+	{
+		bReconstructionDeferred = true;
+	}
+	else
+	{
+		ReconstructNode();
+	}
 }
 
 void UFlowGraphNode::PostDuplicate(bool bDuplicateForPIE)
@@ -151,12 +168,18 @@ void UFlowGraphNode::OnExternalChange()
 	
 	bNeedsFullReconstruction = true;
 
-	ReconstructNode();
-	GetGraph()->NotifyGraphChanged();
+	CastChecked<UFlowGraph>(GetGraph())->RequestNodeReconstruction(this);
 }
 
 void UFlowGraphNode::OnGraphRefresh()
 {
+	// context pins are saved with the graph, rebuild them only if assets providing them have changed since
+	uint32 Fingerprint = 0;
+	if (CalcContextPinsFingerprint(Fingerprint) && Fingerprint == ContextPinsFingerprint)
+	{
+		return;
+	}
+
 	RefreshContextPins(true);
 }
 
@@ -263,6 +286,8 @@ void UFlowGraphNode::ReconstructNode()
 	}
 
 	bNeedsFullReconstruction = false;
+	bReconstructionDeferred = false;
+	InvalidateDisplayCache();
 }
 
 void UFlowGraphNode::AllocateDefaultPins()
@@ -509,6 +534,12 @@ FText UFlowGraphNode::GetNodeTitle(ENodeTitleType::Type TitleType) const
 {
 	if (FlowNode)
 	{
+		ValidateDisplayCache();
+		if (DisplayCache.Title.IsSet())
+		{
+			return DisplayCache.Title.GetValue();
+		}
+
 		if (UFlowGraphEditorSettings::Get()->bShowNodeClass)
 		{
 			FString CleanAssetName;
@@ -526,10 +557,14 @@ FText UFlowGraphNode::GetNodeTitle(ENodeTitleType::Type TitleType) const
 			FFormatNamedArguments Args;
 			Args.Add(TEXT("NodeTitle"), FlowNode->GetNodeTitle());
 			Args.Add(TEXT("AssetName"), FText::FromString(CleanAssetName));
-			return FText::Format(INVTEXT("{NodeTitle}\n{AssetName}"), Args);
+			DisplayCache.Title = FText::Format(INVTEXT("{NodeTitle}\n{AssetName}"), Args);
+		}
+		else
+		{
+			DisplayCache.Title = FlowNode->GetNodeTitle();
 		}
 
-		return FlowNode->GetNodeTitle();
+		return DisplayCache.Title.GetValue();
 	}
 
 	return Super::GetNodeTitle(TitleType);
@@ -539,21 +574,32 @@ FLinearColor UFlowGraphNode::GetNodeTitleColor() const
 {
 	if (FlowNode)
 	{
-		FLinearColor DynamicColor;
-		if (FlowNode->GetDynamicTitleColor(DynamicColor))
+		ValidateDisplayCache();
+		if (DisplayCache.TitleColor.IsSet())
 		{
-			return DynamicColor;
+			return DisplayCache.TitleColor.GetValue();
 		}
 
+		FLinearColor DynamicColor;
 		UFlowGraphSettings* GraphSettings = UFlowGraphSettings::Get();
-		if (const FLinearColor* NodeSpecificColor = GraphSettings->NodeSpecificColors.Find(FlowNode->GetClass()))
+		if (FlowNode->GetDynamicTitleColor(DynamicColor))
+		{
+			DisplayCache.TitleColor = DynamicColor;
+		}
+		else if (const FLinearColor* NodeSpecificColor = GraphSettings->NodeSpecificColors.Find(FlowNode->GetClass()))
+		{
+			DisplayCache.TitleColor = *NodeSpecificColor;
+		}
+		else if (const FLinearColor* StyleColor = GraphSettings->NodeTitleColors.Find(FlowNode->GetNodeStyle()))
 		{
-			return *NodeSpecificColor;
+			DisplayCache.TitleColor = *StyleColor;
 		}
-		if (const FLinearColor* StyleColor = GraphSettings->NodeTitleColors.Find(FlowNode->GetNodeStyle()))
+		else
 		{
-			return *StyleColor;
+			DisplayCache.TitleColor = Super::GetNodeTitleColor();
 		}
+
+		return DisplayCache.TitleColor.GetValue();
 	}
 
 	return Super::GetNodeTitleColor();
@@ -566,23 +612,79 @@ FSlateIcon UFlowGraphNode::GetIconAndTint(FLinearColor& OutColor) const
 
 FText UFlowGraphNode::GetTooltipText() const
 {
-	FText Tooltip;
-	if (FlowNode)
+	if (FlowNode == nullptr)
+	{
+		return GetNodeTitle(ENodeTitleType::ListView);
+	}
+
+	ValidateDisplayCache();
+	if (!DisplayCache.Tooltip.IsSet())
+	{
+		FText Tooltip = FlowNode->GetClass()->GetToolTipText();
+		if (Tooltip.IsEmpty())
+		{
+			Tooltip = GetNodeTitle(ENodeTitleType::ListView);
+		}
+		DisplayCache.Tooltip = Tooltip;
+	}
+
+	return DisplayCache.Tooltip.GetValue();
+}
+
+void UFlowGraphNode::InvalidateDisplayCache()
+{
+	DisplayCache = FFlowGraphNodeDisplayCache();
+}
+
+void UFlowGraphNode::InvalidateAllDisplayCaches()
+{
+	DisplayCacheGeneration++;
+}
+
+void UFlowGraphNode::SubscribeToPropertyChanges()
+{
+	if (!ObjectPropertyChangedHandle.IsValid())
+	{
+		ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&UFlowGraphNode::OnObjectPropertyChanged);
+	}
+}
+
+void UFlowGraphNode::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if (const UFlowNode* ChangedNode = Cast<UFlowNode>(Object))
+	{
+		if (UFlowGraphNode* GraphNode = Cast<UFlowGraphNode>(ChangedNode->GetGraphNode()))
+		{
+			GraphNode->InvalidateDisplayCache();
+		}
+	}
+	// Flow Settings affect titles of some nodes, i.e. bUseAdaptiveNodeTitles
+	else if (Object && (Object->IsA<UFlowSettings>() || Object->IsA<UFlowGraphSettings>() || Object->IsA<UFlowGraphEditorSettings>()))
 	{
-		Tooltip = FlowNode->GetClass()->GetToolTipText();
+		InvalidateAllDisplayCaches();
 	}
-	if (Tooltip.IsEmpty())
+}
+
+void UFlowGraphNode::ValidateDisplayCache() const
+{
+	if (DisplayCache.Generation != DisplayCacheGeneration)
 	{
-		Tooltip = GetNodeTitle(ENodeTitleType::ListView);
+		DisplayCache = FFlowGraphNodeDisplayCache();
+		DisplayCache.Generation = DisplayCacheGeneration;
 	}
-	return Tooltip;
 }
 
 FString UFlowGraphNode::GetNodeDescription() const
 {
 	if (FlowNode && (GEditor->PlayWorld == nullptr || UFlowGraphEditorSettings::Get()->bShowNodeDescriptionWhilePlaying))
 	{
-		return FlowNode->GetNodeDescription();
+		ValidateDisplayCache();
+		if (!DisplayCache.Description.IsSet())
+		{
+			DisplayCache.Description = FlowNode->GetNodeDescription();
+		}
+
+		return DisplayCache.Description.GetValue();
 	}
 
 	return FString();
@@ -690,6 +792,22 @@ void UFlowGraphNode::JumpToDefinition() const
 	}
 }
 
+const TArray<UEdGraphPin*>& UFlowGraphNode::GetInputPins() const
+{
+#if DO_GUARD_SLOW
+	ensureMsgf(!bReconstructionDeferred, TEXT("Reading pins of %s before its graph was reconstructed, use UFlowGraph::GetReconstructedGraph"), *GetPathName());
+#endif
+	return InputPins;
+}
+
+const TArray<UEdGraphPin*>& UFlowGraphNode::GetOutputPins() const
+{
+#if DO_GUARD_SLOW
+	ensureMsgf(!bReconstructionDeferred, TEXT("Reading pins of %s before its graph was reconstructed, use UFlowGraph::GetReconstructedGraph"), *GetPathName());
+#endif
+	return OutputPins;
+}
+
 void UFlowGraphNode::CreateInputPin(const FFlowPin& FlowPin, const int32 Index /*= INDEX_NONE*/)
 {
 	if (FlowPin.PinName.IsNone())
@@ -871,6 +989,9 @@ void UFlowGraphNode::RefreshContextPins(const bool bReconstructNode)
 		FlowNode->OutputPins = NodeDefaults->OutputPins;
 		FlowNode->AddOutputPins(FlowNode->GetContextOutputs());
 
+		uint32 Fingerprint = 0;
+		ContextPinsFingerprint = CalcContextPinsFingerprint(Fingerprint) ? Fingerprint : 0;
+
 		if (bReconstructNode)
 		{
 			ReconstructNode();
@@ -879,6 +1000,66 @@ void UFlowGraphNode::RefreshContextPins(const bool bReconstructNode)
 	}
 }
 
+bool UFlowGraphNode::CalcContextPinsFingerprint(uint32& OutFingerprint) const
+{
+	TArray<FSoftObjectPath> Dependencies;
+	if (!SupportsContextPins() || !FlowNode->GetContextPinsDependencies(Dependencies))
+	{
+		return false;
+	}
+
+	// fingerprint is saved with the node, so it can't use GetTypeHash of names and paths, which differs between editor sessions
+	// FName comparison ignores case, while the case of its string depends on which instance was created first
+	const auto StableHash = [](const FString& String)
+	{
+		return FCrc::StrCrc32(*String.ToLower());
+	};
+
+	// default pins declared by the node class might have changed too
+	const UFlowNode* NodeDefaults = FlowNode->GetClass()->GetDefaultObject<UFlowNode>();
+	uint32 Fingerprint = StableHash(FlowNode->GetClass()->GetPathName());
+	for (const FFlowPin& Pin : NodeDefaults->InputPins)
+	{
+		Fingerprint = HashCombine(Fingerprint, StableHash(Pin.PinName.ToString()));
+	}
+	for (const FFlowPin& Pin : NodeDefaults->OutputPins)
+	{
+		Fingerprint = HashCombine(Fingerprint, StableHash(Pin.PinName.ToString()));
+	}
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(AssetRegistryConstants::ModuleName).Get();
+	for (const FSoftObjectPath& AssetPath : Dependencies)
+	{
+		Fingerprint = HashCombine(Fingerprint, StableHash(AssetPath.ToString()));
+		if (AssetPath.IsNull())
+		{
+			continue;
+		}
+
+		// unsaved changes aren't reflected by the package hash
+		if (const UObject* LoadedAsset = AssetPath.ResolveObject())
+		{
+			if (LoadedAsset->GetPackage()->IsDirty())
+			{
+				return false;
+			}
+		}
+
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetPath.GetLongPackageFName());
+		if (!PackageData.IsSet())
+		{
+			return false;
+		}
+
+		const FIoHash& PackageSavedHash = PackageData->GetPackageSavedHash();
+		Fingerprint = HashCombine(Fingerprint, FCrc::MemCrc32(PackageSavedHash.GetBytes(), sizeof(FIoHash::ByteArray)));
+	}
+
+	// zero is reserved for nodes never refreshed
+	OutFingerprint = Fingerprint != 0 ? Fingerprint : 1;
+	return true;
+}
+
 void UFlowGraphNode::GetPinHoverText(const UEdGraphPin& Pin, FString& HoverTextOut) const
 {
 	// start with the default hover text (from the pin's tool-tip)
@@ -126,11 +126,11 @@ void SFlowGraphNode::GetOverlayBrushes(bool bSelected, const FVector2D WidgetSiz
 	{
 		if (PinBreakpoint.Key.Get()->Direction == EGPD_Input)
 		{
-			GetPinBrush(true, WidgetSize.X, FlowGraphNode->InputPins.IndexOfByKey(PinBreakpoint.Key.Get()), PinBreakpoint.Value, Brushes);
+			GetPinBrush(true, WidgetSize.X, FlowGraphNode->GetInputPins().IndexOfByKey(PinBreakpoint.Key.Get()), PinBreakpoint.Value, Brushes);
 		}
 		else
 		{
-			GetPinBrush(false, WidgetSize.X, FlowGraphNode->OutputPins.IndexOfByKey(PinBreakpoint.Key.Get()), PinBreakpoint.Value, Brushes);
+			GetPinBrush(false, WidgetSize.X, FlowGraphNode->GetOutputPins().IndexOfByKey(PinBreakpoint.Key.Get()), PinBreakpoint.Value, Brushes);
 		}
 	}
 }
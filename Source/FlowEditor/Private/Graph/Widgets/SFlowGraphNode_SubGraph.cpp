@@ -1,6 +1,7 @@
 // Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
 
 #include "Graph/Widgets/SFlowGraphNode_SubGraph.h"
+#include "Graph/FlowGraph.h"
 #include "Graph/FlowGraphEditorSettings.h"
 
 #include "FlowAsset.h"
@@ -19,7 +20,8 @@ TSharedPtr<SToolTip> SFlowGraphNode_SubGraph::GetComplexTooltip()
 		if (UFlowNode* FlowNode = FlowGraphNode->GetFlowNode())
 		{
 			const UFlowAsset* AssetToEdit = Cast<UFlowAsset>(FlowNode->GetAssetToEdit());
-			if (AssetToEdit && AssetToEdit->GetGraph())
+			// preview shows pins as they were saved, reconstructing whole graph on hover could load all assets providing its context pins
+			if (UFlowGraph* SubGraph = AssetToEdit ? Cast<UFlowGraph>(AssetToEdit->GetGraph()) : nullptr)
 			{
 				TSharedPtr<SWidget> TitleBarWidget = SNullWidget::NullWidget;
 				if (UFlowGraphEditorSettings::Get()->bShowSubGraphPath)
@@ -45,7 +47,7 @@ TSharedPtr<SToolTip> SFlowGraphNode_SubGraph::GetComplexTooltip()
 						SNew(SOverlay)
 						+SOverlay::Slot()
 						[
-							SNew(SGraphPreviewer, AssetToEdit->GetGraph())
+							SNew(SGraphPreviewer, SubGraph)
 							.CornerOverlayText(LOCTEXT("FlowNodePreviewGraphOverlayText", "GRAPH PREVIEW"))
 							.ShowGraphStateOverlay(false)
 							.TitleBar(TitleBarWidget)
@@ -103,7 +103,7 @@ void SFlowPalette::Construct(const FArguments& InArgs, TWeakPtr<FFlowAssetEditor
 	FlowAssetEditor = InFlowAssetEditor;
 
 	UpdateCategoryNames();
-	UFlowGraphSchema::OnNodeListChanged.AddSP(this, &SFlowPalette::Refresh);
+	UFlowGraphSchema::OnNodeListChanged.AddSP(this, &SFlowPalette::RequestRefresh);
 
 	struct LocalUtils
 	{
@@ -181,6 +181,23 @@ void SFlowPalette::Refresh()
 	CategoryComboBox->SetSelectedItem(SelectedCategory);
 }
 
+void SFlowPalette::RequestRefresh()
+{
+	if (!bRefreshPending)
+	{
+		bRefreshPending = true;
+		RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SFlowPalette::HandleRefresh));
+	}
+}
+
+EActiveTimerReturnType SFlowPalette::HandleRefresh(double InCurrentTime, float InDeltaTime)
+{
+	bRefreshPending = false;
+	Refresh();
+
+	return EActiveTimerReturnType::Stop;
+}
+
 void SFlowPalette::UpdateCategoryNames()
 {
 	CategoryNames = {MakeShareable(new FString(TEXT("All")))};
@@ -0,0 +1,286 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Tests/FlowTestHarness.h"
+
+#include "FlowAsset.h"
+#include "FlowComponent.h"
+#include "FlowSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "UObject/Package.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(FlowTestHarness)
+
+void UFlowTestGameInstance::InitializeForTest()
+{
+	WorldContext = &GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext->OwningGameInstance = this;
+
+	// unlike InitializeStandalone, don't create systems that Flow doesn't need
+	UWorld::InitializationValues InitValues = UWorld::InitializationValues()
+		.RequiresHitProxies(false)
+		.CreatePhysicsScene(false)
+		.ShouldSimulatePhysics(false)
+		.EnableTraceCollision(false)
+		.CreateNavigation(false)
+		.CreateAISystem(false)
+		.AllowAudioPlayback(false)
+		.SetTransactional(false);
+
+	const FName WorldName = MakeUniqueObjectName(GetTransientPackage(), UWorld::StaticClass(), TEXT("FlowTestWorld"));
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, WorldName, nullptr, false, ERHIFeatureLevel::Num, &InitValues);
+	World->SetGameInstance(this);
+	WorldContext->SetCurrentWorld(World);
+
+	// initializes subsystems, including Flow Subsystem
+	Init();
+}
+
+void UFlowTestGameInstance::ShutdownForTest()
+{
+	UWorld* World = GetWorld();
+	Shutdown();
+
+	if (World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+FFlowTestHarness::FFlowTestHarness(UFlowAsset* InFlowAsset, TSubclassOf<UFlowTestOwner> OwnerClass)
+	: FlowAsset(InFlowAsset)
+	, Instance(nullptr)
+	, Owner(nullptr)
+	, GameInstance(nullptr)
+	, World(nullptr)
+{
+	GameInstance = NewObject<UFlowTestGameInstance>(GEngine);
+	GameInstance->InitializeForTest();
+
+	World = GameInstance->GetWorld();
+	World->InitializeActorsForPlay(FURL());
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	Owner = NewObject<UFlowTestOwner>(GameInstance, OwnerClass ? *OwnerClass : UFlowTestOwner::StaticClass());
+}
+
+FFlowTestHarness::~FFlowTestHarness()
+{
+	if (GameInstance)
+	{
+		GameInstance->ShutdownForTest();
+	}
+}
+
+void FFlowTestHarness::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(FlowAsset);
+	Collector.AddReferencedObject(Instance);
+	Collector.AddReferencedObject(Owner);
+	Collector.AddReferencedObject(GameInstance);
+	Collector.AddReferencedObject(World);
+}
+
+FFlowTestHarness& FFlowTestHarness::Start()
+{
+	UFlowSubsystem* FlowSubsystem = GetFlowSubsystem();
+	if (FlowSubsystem == nullptr)
+	{
+		AddFailure(TEXT("Flow Subsystem hasn't been created for the test game instance"));
+		return *this;
+	}
+
+	Instance = FlowSubsystem->CreateRootFlow(Owner, FlowAsset);
+	if (Instance)
+	{
+		Instance->StartFlow();
+	}
+	else
+	{
+		AddFailure(FString::Printf(TEXT("Failed to create instance of %s"), *GetNameSafe(FlowAsset)));
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::Finish()
+{
+	if (UFlowSubsystem* FlowSubsystem = GetFlowSubsystem())
+	{
+		FlowSubsystem->FinishRootFlow(Owner, FlowAsset, EFlowFinishPolicy::Keep);
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::Advance(const float Seconds, const float StepSeconds)
+{
+	const float Step = FMath::Max(StepSeconds, KINDA_SMALL_NUMBER);
+
+	float RemainingTime = Seconds;
+	while (RemainingTime > KINDA_SMALL_NUMBER)
+	{
+		const float DeltaSeconds = FMath::Min(Step, RemainingTime);
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+		RemainingTime -= DeltaSeconds;
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::TriggerCustomInput(const FName& EventName)
+{
+	if (Instance)
+	{
+		Instance->TriggerCustomInput(EventName);
+	}
+	else
+	{
+		AddFailure(FString::Printf(TEXT("Can't trigger Custom Input %s, flow hasn't been started"), *EventName.ToString()));
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::TriggerInput(const FGuid& NodeGuid, const FName& PinName)
+{
+	if (Instance)
+	{
+		Instance->TriggerInput(NodeGuid, PinName);
+	}
+	else
+	{
+		AddFailure(FString::Printf(TEXT("Can't trigger input %s, flow hasn't been started"), *PinName.ToString()));
+	}
+
+	return *this;
+}
+
+UFlowComponent* FFlowTestHarness::SpawnComponent(const FGameplayTagContainer& IdentityTags)
+{
+	AActor* Actor = World->SpawnActor<AActor>();
+	if (Actor == nullptr)
+	{
+		AddFailure(TEXT("Failed to spawn actor in the test world"));
+		return nullptr;
+	}
+
+	// world has already begun play, so registering component calls its BeginPlay and adds it to the Flow Subsystem
+	UFlowComponent* Component = NewObject<UFlowComponent>(Actor);
+	Component->IdentityTags = IdentityTags;
+	Component->RegisterComponent();
+
+	return Component;
+}
+
+FFlowTestHarness& FFlowTestHarness::SpawnComponent(const FGameplayTagContainer& IdentityTags, UFlowComponent*& OutComponent)
+{
+	OutComponent = SpawnComponent(IdentityTags);
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::NotifyGraph(UFlowComponent* Component, const FGameplayTag& NotifyTag)
+{
+	if (Component)
+	{
+		Component->NotifyGraph(NotifyTag);
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::ExpectInput(const FGuid& NodeGuid, const FName& PinName, const int32 MinActivations)
+{
+	const int32 Activations = GetInputActivations(NodeGuid, PinName);
+	if (Activations < MinActivations)
+	{
+		AddFailure(FString::Printf(TEXT("Expected at least %d activations of input %s, got %d"), MinActivations, *PinName.ToString(), Activations));
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::ExpectOutput(const FGuid& NodeGuid, const FName& PinName, const int32 MinActivations)
+{
+	const int32 Activations = GetOutputActivations(NodeGuid, PinName);
+	if (Activations < MinActivations)
+	{
+		AddFailure(FString::Printf(TEXT("Expected at least %d activations of output %s, got %d"), MinActivations, *PinName.ToString(), Activations));
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::ExpectNoOutput(const FGuid& NodeGuid, const FName& PinName)
+{
+	const int32 Activations = GetOutputActivations(NodeGuid, PinName);
+	if (Activations > 0)
+	{
+		AddFailure(FString::Printf(TEXT("Expected no activations of output %s, got %d"), *PinName.ToString(), Activations));
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::ExpectActive()
+{
+	if (Instance == nullptr || !Instance->IsActive())
+	{
+		AddFailure(TEXT("Expected flow to be active"));
+	}
+
+	return *this;
+}
+
+FFlowTestHarness& FFlowTestHarness::ExpectFinished()
+{
+	if (Instance == nullptr || Instance->IsActive())
+	{
+		AddFailure(TEXT("Expected flow to be finished"));
+	}
+
+	return *this;
+}
+
+UFlowNode* FFlowTestHarness::FindNode(const UClass* NodeClass) const
+{
+	if (Instance)
+	{
+		for (const TPair<FGuid, UFlowNode*>& Node : Instance->GetNodes())
+		{
+			if (Node.Value && Node.Value->IsA(NodeClass))
+			{
+				return Node.Value;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+int32 FFlowTestHarness::GetInputActivations(const FGuid& NodeGuid, const FName& PinName) const
+{
+	const UFlowNode* Node = Instance ? Instance->GetNode(NodeGuid) : nullptr;
+	return Node ? Node->InputRecords.FindRef(PinName).Num() : 0;
+}
+
+int32 FFlowTestHarness::GetOutputActivations(const FGuid& NodeGuid, const FName& PinName) const
+{
+	const UFlowNode* Node = Instance ? Instance->GetNode(NodeGuid) : nullptr;
+	return Node ? Node->OutputRecords.FindRef(PinName).Num() : 0;
+}
+
+UFlowSubsystem* FFlowTestHarness::GetFlowSubsystem() const
+{
+	return GameInstance ? GameInstance->GetSubsystem<UFlowSubsystem>() : nullptr;
+}
+
+void FFlowTestHarness::AddFailure(const FString& Failure)
+{
+	Failures.Add(Failure);
+}
+#endif
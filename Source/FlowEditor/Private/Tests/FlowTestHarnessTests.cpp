@@ -0,0 +1,82 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#include "Tests/FlowTestHarness.h"
+#include "Graph/FlowGraph.h"
+#include "Graph/FlowGraphSchema_Actions.h"
+#include "Graph/Nodes/FlowGraphNode.h"
+
+#include "FlowAsset.h"
+#include "Nodes/Route/FlowNode_Finish.h"
+#include "Nodes/Route/FlowNode_Start.h"
+#include "Nodes/Route/FlowNode_Timer.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FlowTestHarnessTests
+{
+	UFlowGraphNode* FindGraphNode(const UEdGraph* Graph, const UClass* NodeClass)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(Node);
+			if (FlowGraphNode && FlowGraphNode->GetFlowNode() && FlowGraphNode->GetFlowNode()->IsA(NodeClass))
+			{
+				return FlowGraphNode;
+			}
+		}
+		return nullptr;
+	}
+
+	bool Connect(UEdGraph* Graph, UFlowGraphNode* From, const FName& OutputName, UFlowGraphNode* To, const FName& InputName)
+	{
+		UEdGraphPin* OutputPin = From->FindPin(OutputName, EGPD_Output);
+		UEdGraphPin* InputPin = To->FindPin(InputName, EGPD_Input);
+		return OutputPin && InputPin && Graph->GetSchema()->TryCreateConnection(OutputPin, InputPin);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlowTestHarnessTimerTest, "Flow.TestHarness.Timer", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFlowTestHarnessTimerTest::RunTest(const FString& Parameters)
+{
+	using namespace FlowTestHarnessTests;
+
+	// Start -> Timer (default completion time of 1 second) -> Finish
+	UFlowAsset* FlowAsset = NewObject<UFlowAsset>(GetTransientPackage(), NAME_None, RF_Transient);
+	UEdGraph* Graph = UFlowGraph::CreateGraph(FlowAsset);
+
+	UFlowGraphNode* StartNode = FindGraphNode(Graph, UFlowNode_Start::StaticClass());
+	UFlowGraphNode* TimerNode = FFlowGraphSchemaAction_NewNode::CreateNode(Graph, nullptr, UFlowNode_Timer::StaticClass(), FVector2D(256.0f, 0.0f), false);
+	UFlowGraphNode* FinishNode = FFlowGraphSchemaAction_NewNode::CreateNode(Graph, nullptr, UFlowNode_Finish::StaticClass(), FVector2D(512.0f, 0.0f), false);
+
+	if (!TestNotNull(TEXT("Start node"), StartNode)
+		|| !TestTrue(TEXT("Start is connected to Timer"), Connect(Graph, StartNode, UFlowNode::DefaultOutputPin.PinName, TimerNode, UFlowNode::DefaultInputPin.PinName))
+		|| !TestTrue(TEXT("Timer is connected to Finish"), Connect(Graph, TimerNode, TEXT("Completed"), FinishNode, UFlowNode::DefaultInputPin.PinName)))
+	{
+		return false;
+	}
+
+	FlowAsset->HarvestNodeConnections();
+
+	FFlowTestHarness Harness(FlowAsset);
+	Harness.Start()
+		.ExpectActive()
+		.Advance(0.5f)
+		.ExpectNoOutput(TimerNode->GetFlowNode()->GetGuid(), TEXT("Completed"))
+		.ExpectActive()
+		.Advance(1.0f)
+		.ExpectOutput<UFlowNode_Timer>(TEXT("Completed"))
+		.ExpectFinished();
+
+	for (const FString& Failure : Harness.GetFailures())
+	{
+		AddError(Failure);
+	}
+
+	return Harness.Succeeded();
+}
+
+#endif
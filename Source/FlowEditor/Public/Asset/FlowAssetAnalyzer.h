@@ -0,0 +1,85 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "Containers/UnrealString.h"
+
+class FFlowMessageLog;
+class UFlowAsset;
+struct FAssetData;
+class UFlowNode;
+
+// Static cost metrics of the Flow Asset, computed without running the graph
+struct FLOWEDITOR_API FFlowAssetComplexity
+{
+	int32 NodeCount;
+
+	// Longest chain of nodes that might be executed in a single frame, latent nodes break the chain
+	int32 MaxSynchronousChainDepth;
+
+	// Nodes subscribing to the Flow Component registry, including nested Sub Graphs
+	int32 ObserverNodeCount;
+
+	// How deep Sub Graphs are nested, 0 if asset doesn't use Sub Graphs
+	int32 SubGraphDepth;
+
+	// Estimated memory of a single asset instance, including instances of nested Sub Graphs
+	int64 EstimatedInstanceMemory;
+
+	// Estimated size of SaveGame data, if every node would be active at the same time
+	int64 EstimatedSaveSize;
+
+	FFlowAssetComplexity()
+		: NodeCount(0)
+		, MaxSynchronousChainDepth(0)
+		, ObserverNodeCount(0)
+		, SubGraphDepth(0)
+		, EstimatedInstanceMemory(0)
+		, EstimatedSaveSize(0)
+	{
+	}
+
+	FString ToString() const;
+
+	friend FArchive& operator<<(FArchive& Ar, FFlowAssetComplexity& Complexity)
+	{
+		Ar << Complexity.NodeCount;
+		Ar << Complexity.MaxSynchronousChainDepth;
+		Ar << Complexity.ObserverNodeCount;
+		Ar << Complexity.SubGraphDepth;
+		Ar << Complexity.EstimatedInstanceMemory;
+		Ar << Complexity.EstimatedSaveSize;
+		return Ar;
+	}
+};
+
+/**
+ * Computes static cost metrics of Flow Assets and compares them against budgets set in Flow Graph Settings
+ * Used by the Flow Asset editor and the FlowComplexity commandlet
+ */
+class FLOWEDITOR_API FFlowAssetAnalyzer
+{
+public:
+	static FFlowAssetComplexity Analyze(UFlowAsset* FlowAsset);
+
+	/**
+	 * Returns metrics cached in the Derived Data Cache, keyed by saved hashes of the asset package and every package it depends on
+	 * Asset is loaded and analyzed only on cache miss, so scans of unchanged assets are cheap
+	 */
+	static FFlowAssetComplexity AnalyzeCached(const FAssetData& AssetData);
+
+	// Adds warning for every metric exceeding its budget, returns false if any budget has been exceeded
+	static bool CheckBudgets(UFlowAsset* FlowAsset, const FFlowAssetComplexity& Complexity, FFlowMessageLog& MessageLog);
+
+private:
+	// Returns false if cache key can't be computed, i.e. asset has unsaved changes
+	static bool GetCacheKey(const FAssetData& AssetData, FString& OutCacheKey);
+
+	static void AnalyzeAsset(UFlowAsset* FlowAsset, const int32 SubGraphDepth, TSet<const UFlowAsset*>& VisitedAssets, FFlowAssetComplexity& OutComplexity);
+	// Nodes In Chain maps nodes of the currently visited chain to their position in it
+	// Out Lowest Loop Start is position of the earliest node in chain where a loop has been cut, MAX_int32 if none
+	static int32 GetSynchronousChainDepth(UFlowNode* Node, TMap<const UFlowNode*, int32>& CachedDepths, TMap<const UFlowNode*, int32>& NodesInChain, int32& OutLowestLoopStart);
+	static bool IsLatentNode(const UFlowNode* Node);
+};
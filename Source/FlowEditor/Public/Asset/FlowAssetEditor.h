@@ -110,10 +110,15 @@ public:
 private:
 	TSharedRef<SDockTab> SpawnTab_Details(const FSpawnTabArgs& Args) const;
 	TSharedRef<SDockTab> SpawnTab_Graph(const FSpawnTabArgs& Args) const;
-	TSharedRef<SDockTab> SpawnTab_Palette(const FSpawnTabArgs& Args) const;
-	TSharedRef<SDockTab> SpawnTab_RuntimeLog(const FSpawnTabArgs& Args) const;
-	TSharedRef<SDockTab> SpawnTab_Search(const FSpawnTabArgs& Args) const;
-	TSharedRef<SDockTab> SpawnTab_ValidationLog(const FSpawnTabArgs& Args) const;
+	TSharedRef<SDockTab> SpawnTab_Palette(const FSpawnTabArgs& Args);
+	TSharedRef<SDockTab> SpawnTab_RuntimeLog(const FSpawnTabArgs& Args);
+	TSharedRef<SDockTab> SpawnTab_Search(const FSpawnTabArgs& Args);
+	TSharedRef<SDockTab> SpawnTab_ValidationLog(const FSpawnTabArgs& Args);
+
+	TSharedRef<SWidget> GetTabContent(const TSharedPtr<SWidget>& Panel, TSharedRef<SWidget> (FFlowAssetEditor::*CreatePanel)());
+
+	// Returns placeholder filled by the panel on its first paint, so panels of tabs never shown aren't built
+	static TSharedRef<SWidget> CreateLazyPanel(TFunction<TSharedRef<SWidget>()> CreatePanel);
 
 public:
 	/** Edits the specified FlowAsset object */
@@ -130,6 +135,7 @@ private:
 
 protected:
 	virtual void ValidateAsset(FFlowMessageLog& MessageLog);
+	virtual void AnalyzeAsset();
 	virtual void SearchInAsset();
 
 	void EditAssetDefaults_Clicked() const;
@@ -140,6 +146,12 @@ protected:
 	virtual void CreateWidgets();
 	virtual void CreateGraphWidget();
 
+	// Panels are created when their tab becomes visible for the first time
+	virtual TSharedRef<SWidget> CreatePaletteWidget();
+	virtual TSharedRef<SWidget> CreateSearchWidget();
+	virtual TSharedRef<SWidget> CreateRuntimeLogWidget();
+	virtual TSharedRef<SWidget> CreateValidationLogWidget();
+
 	static bool CanEdit();
 
 public:
@@ -27,6 +27,10 @@ public:
 private:
 	void RefreshInstances();
 
+	// Refresh is deferred to the next paint, so editors in background tabs don't process debugger events
+	void RequestRefreshInstances();
+	EActiveTimerReturnType HandleRefreshInstances(double InCurrentTime, float InDeltaTime);
+
 	TSharedRef<SWidget> OnGenerateWidget(TSharedPtr<FName> Item) const;
 	void OnSelectionChanged(TSharedPtr<FName> SelectedItem, ESelectInfo::Type SelectionType);
 	FText GetSelectedInstanceName() const;
@@ -37,6 +41,8 @@ private:
 	TArray<TSharedPtr<FName>> InstanceNames;
 	TSharedPtr<FName> SelectedInstance;
 
+	bool bRefreshPending = false;
+
 	static FText NoInstanceSelectedText;
 };
 
@@ -0,0 +1,19 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "FlowComplexityCommandlet.generated.h"
+
+/**
+ * Computes complexity metrics of every Flow Asset and compares them against budgets from Flow Graph Settings
+ * Returns non-zero exit code if any asset exceeds a budget, so it can be used as a CI step
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=FlowComplexity [-Path=/Game/Quests] [-BatchSize=50]
+ */
+UCLASS()
+class FLOWEDITOR_API UFlowComplexityCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,27 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "FlowNodeReplaceCommandlet.generated.h"
+
+class UFlowAsset;
+class UFlowNode;
+
+/**
+ * Replaces node class and/or renames pins in every Flow Asset using given node class
+ * Assets are loaded, validated and saved in batches, memory is released between batches
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=FlowNodeReplace -From=/Script/Module.OldNode [-To=/Script/Module.NewNode] [-Pins=OldIn:NewIn,OldOut:NewOut] [-Path=/Game] [-BatchSize=50] [-DryRun]
+ */
+UCLASS()
+class FLOWEDITOR_API UFlowNodeReplaceCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	// Returns number of replaced nodes
+	int32 ReplaceNodes(UFlowAsset* FlowAsset, const UClass* FromClass, const UClass* ToClass, const TMap<FName, FName>& PinRedirects) const;
+	UFlowNode* ReplaceNodeClass(UFlowAsset* FlowAsset, UFlowNode* OldNode, const UClass* ToClass) const;
+};
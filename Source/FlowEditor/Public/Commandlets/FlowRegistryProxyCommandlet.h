@@ -0,0 +1,19 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "FlowRegistryProxyCommandlet.generated.h"
+
+/**
+ * Gathers Flow Components of actors placed in World Partition cells and stores them as proxies in Flow World Settings
+ * Flow Subsystem uses these proxies to find actors before their cell is loaded, i.e. to queue notifies for them
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=FlowRegistryProxy -Map=/Game/Maps/OpenWorld
+ */
+UCLASS()
+class FLOWEDITOR_API UFlowRegistryProxyCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	virtual int32 Main(const FString& Params) override;
+};
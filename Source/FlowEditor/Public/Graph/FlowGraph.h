@@ -25,10 +25,30 @@ class FLOWEDITOR_API UFlowGraph : public UEdGraph
 	static UEdGraph* CreateGraph(UFlowAsset* InFlowAsset, TSubclassOf<UFlowGraphSchema> FlowSchema);
 	void RefreshGraph();
 
+	// Returns graph of the asset with all nodes up-to-date, call it before graph is displayed, diffed or searched
+	static UFlowGraph* GetReconstructedGraph(const UFlowAsset* FlowAsset);
+
+	// Reconstructs nodes which skipped reconstruction on load
+	void ReconstructDeferredNodes();
+
 	// UEdGraph
 	virtual void NotifyGraphChanged() override;
 	// --
 
+	// Reconstructs node immediately, graph change is notified on the next editor tick
+	// Requests made in the meantime are handled by a single graph refresh
+	void RequestNodeReconstruction(class UFlowGraphNode* GraphNode);
+
+	// Notifies pending graph change immediately, if graph has to be up-to-date before the next tick
+	void FlushPendingGraphChange();
+
 	/** Returns the FlowAsset that contains this graph */
 	UFlowAsset* GetFlowAsset() const;
+
+private:
+	bool bGraphChangeScheduled = false;
+
+	// While refreshing graph, nodes changes are reported by a single NotifyGraphChanged call
+	bool bBatchingGraphChanges = false;
+	bool bGraphChangedWhileBatching = false;
 };
@@ -107,6 +107,29 @@ class FLOWEDITOR_API UFlowGraphSettings : public UDeveloperSettings
 	UPROPERTY(EditAnywhere, config, Category = "Wires", meta = (ClampMin = 0.0f))
 	float SelectedWireThickness;
 
+	/** Budgets used by Analyze toolbar button and FlowComplexity commandlet. Value of 0 disables the check */
+	UPROPERTY(EditAnywhere, config, Category = "Complexity", meta = (ClampMin = 0))
+	int32 MaxNodeCount;
+
+	/** Longest chain of nodes executed in a single frame, latent nodes break the chain */
+	UPROPERTY(EditAnywhere, config, Category = "Complexity", meta = (ClampMin = 0))
+	int32 MaxSynchronousChainDepth;
+
+	/** Nodes subscribing to the Flow Component registry, including nested Sub Graphs */
+	UPROPERTY(EditAnywhere, config, Category = "Complexity", meta = (ClampMin = 0))
+	int32 MaxObserverNodeCount;
+
+	UPROPERTY(EditAnywhere, config, Category = "Complexity", meta = (ClampMin = 0))
+	int32 MaxSubGraphDepth;
+
+	/** Estimated memory of a single asset instance, in kilobytes */
+	UPROPERTY(EditAnywhere, config, Category = "Complexity", meta = (ClampMin = 0, Units = "Kilobytes"))
+	int32 MaxInstanceMemory;
+
+	/** Estimated size of SaveGame data of a single asset instance, in kilobytes */
+	UPROPERTY(EditAnywhere, config, Category = "Complexity", meta = (ClampMin = 0, Units = "Kilobytes"))
+	int32 MaxSaveSize;
+
 public:
 	virtual FName GetCategoryName() const override { return FName("Flow Graph"); }
 	virtual FText GetSectionText() const override { return INVTEXT("Graph Settings"); }
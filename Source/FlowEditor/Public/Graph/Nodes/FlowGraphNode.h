@@ -15,6 +15,17 @@ class UFlowNode;
 
 DECLARE_DELEGATE(FFlowGraphNodeEvent);
 
+// Display data requested by Slate widgets, search and tooltips, cached to avoid running script on every paint
+struct FFlowGraphNodeDisplayCache
+{
+	TOptional<FText> Title;
+	TOptional<FText> Tooltip;
+	TOptional<FString> Description;
+	TOptional<FLinearColor> TitleColor;
+
+	uint32 Generation = 0;
+};
+
 /**
  * Graph representation of the Flow Node
  */
@@ -34,6 +45,10 @@ private:
 	bool bNeedsFullReconstruction;
 	static bool bFlowAssetsLoaded;
 
+	// Reconstruction skipped on load, executed by UFlowGraph once the graph is actually needed
+	// Only load-time work is skipped, graph is still loaded with the asset. Saving graph that was never opened keeps its loaded pins
+	bool bReconstructionDeferred;
+
 public:
 	// It would be intuitive to assign a custom Graph Node class in Flow Node class
 	// However, we shouldn't assign class from editor module to runtime module class
@@ -86,6 +101,8 @@ public:
 	 */
 	void InsertNewNode(UEdGraphPin* FromPin, UEdGraphPin* NewLinkPin, TSet<UEdGraphNode*>& OutNodeList);
 
+	bool IsReconstructionDeferred() const { return bReconstructionDeferred; }
+
 	// UEdGraphNode
 	virtual void ReconstructNode() override;
 	virtual void AllocateDefaultPins() override;
@@ -108,6 +125,24 @@ public:
 	virtual FText GetTooltipText() const override;
 	// --
 
+	// Invalidates cached title, description, tooltip and title color of this node
+	void InvalidateDisplayCache();
+
+	// Invalidates display cache of all nodes, i.e. after changing settings or recompiling node blueprints
+	static void InvalidateAllDisplayCaches();
+
+	// Safe to call many times, handler is added only once
+	static void SubscribeToPropertyChanges();
+
+private:
+	static void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+	static FDelegateHandle ObjectPropertyChangedHandle;
+
+	void ValidateDisplayCache() const;
+
+	mutable FFlowGraphNodeDisplayCache DisplayCache;
+	static uint32 DisplayCacheGeneration;
+
 //////////////////////////////////////////////////////////////////////////
 // Utils
 
@@ -142,6 +177,11 @@ public:
 	TArray<UEdGraphPin*> InputPins;
 	TArray<UEdGraphPin*> OutputPins;
 
+	// These arrays are filled by reconstruction, they're empty while reconstruction is deferred
+	// Code outside of this node should read pins via these, debug builds ensure the graph was reconstructed
+	const TArray<UEdGraphPin*>& GetInputPins() const;
+	const TArray<UEdGraphPin*>& GetOutputPins() const;
+
 	UPROPERTY()
 	TMap<FEdGraphPinReference, FFlowPinTrait> PinBreakpoints;
 
@@ -170,6 +210,15 @@ public:
 	// Create pins from the context asset, i.e. Sequencer events
 	void RefreshContextPins(const bool bReconstructNode);
 
+private:
+	// Fingerprint of assets providing context pins at the time of the last refresh, zero if unknown
+	UPROPERTY()
+	uint32 ContextPinsFingerprint;
+
+	bool CalcContextPinsFingerprint(uint32& OutFingerprint) const;
+
+public:
+
 	// UEdGraphNode
 	virtual void GetPinHoverText(const UEdGraphPin& Pin, FString& HoverTextOut) const override;
 	// --
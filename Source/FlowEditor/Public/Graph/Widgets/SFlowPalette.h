@@ -34,6 +34,10 @@ protected:
 	void Refresh();
 	void UpdateCategoryNames();
 
+	// Refresh is deferred to the next paint, so palettes in background tabs don't rebuild on every node list change
+	void RequestRefresh();
+	EActiveTimerReturnType HandleRefresh(double InCurrentTime, float InDeltaTime);
+
 	// SGraphPalette
 	virtual TSharedRef<SWidget> OnCreateWidgetForAction(FCreateWidgetForActionData* const InCreateData) override;
 	virtual void CollectAllActions(FGraphActionListBuilderBase& OutAllActions) override;
@@ -51,4 +55,6 @@ protected:
 	TWeakPtr<FFlowAssetEditor> FlowAssetEditor;
 	TArray<TSharedPtr<FString>> CategoryNames;
 	TSharedPtr<STextComboBox> CategoryComboBox;
+
+	bool bRefreshPending = false;
 };
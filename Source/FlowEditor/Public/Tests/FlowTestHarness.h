@@ -0,0 +1,136 @@
+// Copyright https://github.com/MothCocoon/FlowGraph/graphs/contributors
+
+#pragma once
+
+#include "Engine/GameInstance.h"
+#include "GameplayTagContainer.h"
+#include "UObject/Object.h"
+
+#include "FlowOwnerInterface.h"
+#include "Nodes/FlowNode.h"
+#include "FlowTestHarness.generated.h"
+
+class UFlowAsset;
+class UFlowComponent;
+class UFlowSubsystem;
+class UGameInstance;
+
+/**
+ * Minimal owner of the Flow Asset instance started by the test harness
+ * Subclass it to expose functions called by CallOwnerFunction nodes
+ */
+UCLASS(Transient)
+class FLOWEDITOR_API UFlowTestOwner : public UObject, public IFlowOwnerInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Game instance hosting Flow Subsystem for the test harness
+ * Its world is created without physics, navigation, AI, audio or any level content
+ */
+UCLASS(Transient)
+class FLOWEDITOR_API UFlowTestGameInstance : public UGameInstance
+{
+	GENERATED_BODY()
+
+public:
+	void InitializeForTest();
+	void ShutdownForTest();
+};
+
+#if WITH_DEV_AUTOMATION_TESTS
+/**
+ * Runs a Flow Asset without a map, game mode or real time, i.e. from automation tests executed with -nullrhi
+ * Every harness creates its own lightweight game instance and world, so Flow Subsystem and its component registry are isolated from other tests
+ * World time is advanced only by calling Advance()
+ *
+ * FFlowTestHarness Harness(FlowAsset);
+ * Harness.Start()
+ *	.Advance(2.0f)
+ *	.TriggerCustomInput(TEXT("OpenDoor"))
+ *	.ExpectOutput<UFlowNode_Timer>(TEXT("Completed"))
+ *	.ExpectFinished();
+ * TestTrue(TEXT("Flow executed as expected"), Harness.Succeeded());
+ */
+class FLOWEDITOR_API FFlowTestHarness : public FGCObject
+{
+public:
+	explicit FFlowTestHarness(UFlowAsset* InFlowAsset, TSubclassOf<UFlowTestOwner> OwnerClass = nullptr);
+	virtual ~FFlowTestHarness() override;
+
+	// FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FFlowTestHarness"); }
+	// --
+
+	FFlowTestHarness& Start();
+	FFlowTestHarness& Finish();
+
+	// Ticks the isolated world in fixed steps, so timers and latent nodes progress deterministically
+	FFlowTestHarness& Advance(const float Seconds, const float StepSeconds = 1.0f / 30.0f);
+
+	FFlowTestHarness& TriggerCustomInput(const FName& EventName);
+	FFlowTestHarness& TriggerInput(const FGuid& NodeGuid, const FName& PinName);
+
+	// Spawns actor with Flow Component registered in the isolated Flow Subsystem
+	UFlowComponent* SpawnComponent(const FGameplayTagContainer& IdentityTags);
+	FFlowTestHarness& SpawnComponent(const FGameplayTagContainer& IdentityTags, UFlowComponent*& OutComponent);
+
+	// Sends notify from the component, as observed by OnNotifyFromActor nodes
+	FFlowTestHarness& NotifyGraph(UFlowComponent* Component, const FGameplayTag& NotifyTag);
+
+	// Expectations, failures are collected and reported by GetFailures()
+	FFlowTestHarness& ExpectInput(const FGuid& NodeGuid, const FName& PinName, const int32 MinActivations = 1);
+	FFlowTestHarness& ExpectOutput(const FGuid& NodeGuid, const FName& PinName, const int32 MinActivations = 1);
+	FFlowTestHarness& ExpectNoOutput(const FGuid& NodeGuid, const FName& PinName);
+	FFlowTestHarness& ExpectActive();
+	FFlowTestHarness& ExpectFinished();
+
+	template <class T>
+	FFlowTestHarness& ExpectOutput(const FName& PinName, const int32 MinActivations = 1)
+	{
+		const UFlowNode* Node = FindNode<T>();
+		return ExpectOutput(Node ? Node->GetGuid() : FGuid(), PinName, MinActivations);
+	}
+
+	template <class T>
+	FFlowTestHarness& ExpectInput(const FName& PinName, const int32 MinActivations = 1)
+	{
+		const UFlowNode* Node = FindNode<T>();
+		return ExpectInput(Node ? Node->GetGuid() : FGuid(), PinName, MinActivations);
+	}
+
+	// Returns first node of given class in the running instance
+	template <class T>
+	T* FindNode() const
+	{
+		return Cast<T>(FindNode(T::StaticClass()));
+	}
+
+	UFlowNode* FindNode(const UClass* NodeClass) const;
+
+	int32 GetInputActivations(const FGuid& NodeGuid, const FName& PinName) const;
+	int32 GetOutputActivations(const FGuid& NodeGuid, const FName& PinName) const;
+
+	UFlowAsset* GetInstance() const { return Instance; }
+	UFlowTestOwner* GetOwner() const { return Owner; }
+	UFlowSubsystem* GetFlowSubsystem() const;
+	UWorld* GetWorld() const { return World; }
+
+	bool Succeeded() const { return Failures.Num() == 0; }
+	const TArray<FString>& GetFailures() const { return Failures; }
+
+private:
+	void AddFailure(const FString& Failure);
+
+	UFlowAsset* FlowAsset;
+	UFlowAsset* Instance;
+	UFlowTestOwner* Owner;
+
+	UFlowTestGameInstance* GameInstance;
+	UWorld* World;
+
+	TArray<FString> Failures;
+};
+#endif